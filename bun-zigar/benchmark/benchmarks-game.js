@@ -0,0 +1,9 @@
+import { getBenchmarkOptions, runBenchmarks } from '../../zigar-compiler/test/integration/benchmark.js';
+import { getBenchmarks } from '../../zigar-compiler/test/integration/benchmarks-game/benchmarks.js';
+
+const options = getBenchmarkOptions({ platform: 'bun-zigar' });
+await runBenchmarks('Zig Benchmarks Game', getBenchmarks(), importModule, options);
+
+async function importModule(url, { optimize }) {
+  return import(`${url}?optimize=${optimize}`);
+}
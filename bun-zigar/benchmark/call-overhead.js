@@ -0,0 +1,54 @@
+import { performance } from 'perf_hooks';
+import { getBenchmarkOptions } from '../../zigar-compiler/test/integration/benchmark.js';
+import { getBenchmarks } from '../../zigar-compiler/test/integration/marshalling/benchmarks.js';
+
+// compare the cost of calling into Zig through bun:ffi against going through the Node-API
+// addon, using the same module
+const options = getBenchmarkOptions({ platform: 'bun-zigar' });
+const { optimize, repeat, filter } = options;
+const names = [
+  'void', 'i32', 'f64', 'struct', 'pointer', 'allocator', 'slice (typed array)', 'string', 'return string',
+];
+const cases = getBenchmarks().filter(({ name }) => names.includes(name) && (!filter || name.includes(filter)));
+const paths = [
+  { label: 'bun:ffi', query: `optimize=${optimize}` },
+  { label: 'Node-API', query: `optimize=${optimize}&node-api=1` },
+];
+
+async function measure(module, { run, setup }, size) {
+  const input = await setup?.(size, module);
+  // untimed warm-up run
+  const count = await run(module, size, input);
+  const times = [];
+  for (let i = 0; i < repeat; i++) {
+    const start = performance.now();
+    await run(module, size, input);
+    times.push(performance.now() - start);
+  }
+  times.sort((a, b) => a - b);
+  return times[times.length >> 1] * 1e6 / count;
+}
+
+console.log(`\nCall overhead (bun ${Bun.version}, ${optimize})`);
+console.log([
+  'case'.padEnd(36),
+  ...paths.map(({ label }) => `${label} ns/call`.padStart(18)),
+  'speed-up'.padStart(10),
+].join('  '));
+const modules = {};
+for (const { name, url, sizes, ...rest } of cases) {
+  for (const size of sizes.slice(0, 1)) {
+    const results = [];
+    for (const { label, query } of paths) {
+      const key = `${url}?${query}`;
+      modules[key] ??= await import(key);
+      results.push(await measure(modules[key], rest, size));
+    }
+    const [ ffi, napi ] = results;
+    console.log([
+      `${name} (${size})`.padEnd(36),
+      ...results.map(t => t.toFixed(1).padStart(18)),
+      `${(napi / ffi).toFixed(2)}x`.padStart(10),
+    ].join('  '));
+  }
+}
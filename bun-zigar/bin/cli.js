@@ -4,8 +4,8 @@ import { readFile, writeFile } from 'fs/promises';
 import { buildAddon } from 'node-zigar-addon';
 import os from 'os';
 import { dirname, join, parse } from 'path';
-import { compile, findConfigFile, optionsForCompile } from 'zigar-compiler';
-import { loadConfigFile } from '../dist/config.js';
+import { compile, findConfigFile } from 'zigar-compiler';
+import { loadConfigFile, optionsForBun } from '../dist/config.js';
 import { hideStatus, showResult, showStatus } from '../dist/status.js';
 
 const possiblePlatforms = [
@@ -22,7 +22,7 @@ async function buildModules() {
   if (!configPath) {
     throw new Error('Unable to find bun-zigar.toml');
   }
-  const config = await loadConfigFile(configPath, optionsForCompile);
+  const config = await loadConfigFile(configPath, optionsForBun);
   if (!Array.isArray(config.targets)) {
     throw new Error('Unable to find array "targets" in bun-zigar.toml');
   }
@@ -66,7 +66,8 @@ async function buildModules() {
       parentDirs.push(parentDir);
     }
   }
-  for (const parentDir of parentDirs) {
+  // the addon isn't needed when calls go through bun:ffi instead of Node-API
+  for (const parentDir of (config.nodeAPI !== false) ? parentDirs : []) {
     const addonDir = join(parentDir, 'node-zigar-addon');
     for (const { platform, arch } of config.targets) {
       const { changed } = await buildAddon(addonDir, {
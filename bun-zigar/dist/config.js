@@ -1,4 +1,13 @@
 import { dirname, resolve } from 'path';
+import { optionsForCompile } from 'zigar-compiler';
+
+export const optionsForBun = {
+  ...optionsForCompile,
+  nodeAPI: {
+    type: 'boolean',
+    title: 'Call Zig functions through the Node-API addon; set to false to use bun:ffi instead',
+  },
+};
 
 export async function loadConfigFile(cfgPath, availableOptions) {
   const { default: options } = await import(cfgPath);
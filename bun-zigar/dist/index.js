@@ -4,9 +4,10 @@ import { dirname, extname, join, parse } from 'path';
 import { pathToFileURL } from 'url';
 import {
   compile, extractOptions, findConfigFile, findSourceFile, generateCode, getArch, getCachePath,
-  getModuleCachePath, getPlatform, normalizePath, optionsForCompile
+  getModuleCachePath, getPlatform, normalizePath
 } from 'zigar-compiler';
-import { loadConfigFile } from './config.js';
+import { loadConfigFile, optionsForBun } from './config.js';
+import { createEnvironment as createBunEnvironment } from './runtime.js';
 import { hideStatus, showStatus } from './status.js';
 
 await plugin({
@@ -29,20 +30,21 @@ await plugin({
         optimize: 'Debug',
         platform,
         arch,
+        nodeAPI: true,
       };
       const configPath = await findConfigFile('bun-zigar.toml', dirname(path));
       if (configPath) {
         // add options from config file
-        Object.assign(options, await loadConfigFile(configPath, optionsForCompile));
+        Object.assign(options, await loadConfigFile(configPath, optionsForBun));
       }
       // allow overriding of options using query variables
-      Object.assign(options, extractOptions(new URL(url).searchParams, optionsForCompile));
+      Object.assign(options, extractOptions(new URL(url).searchParams, optionsForBun));
       const ext = extname(path);
       const srcPath = (ext === '.zig') ? path : findSourceFile(path, options);
       const modPath = (ext === '.zig') ? getModuleCachePath(path, options) : path;
       const addonParentDir = (ext === '.zig') ? getCachePath(options) : dirname(path);
       const addonDir = join(addonParentDir, 'node-zigar-addon');
-      // build the Node-API addon if necessary
+      // build the Node-API addon if necessary; it isn't needed when bun:ffi is used
       const addonOptions = { recompile: true };
       if (!options.quiet) {
         const modName = parse(path).name;
@@ -55,19 +57,21 @@ await plugin({
           onEnd: () => hideStatus(),
         });
       }
-      const { outputPath: addonPath } = await buildAddon(addonDir, addonOptions);
+      const addonPath = (options.nodeAPI) ? (await buildAddon(addonDir, addonOptions)).outputPath : undefined;
       // compile the module if srcPath isn't undefined; if it is, then compile() will simply return
       // the path to the matching so/dylib/dll file in modPath; basically, when node-zigar.config.json
       // is absent, compilation does not occur
       const { outputPath } = await compile(srcPath, modPath, options);
-      const env = createEnvironment({ addonPath });
+      const env = (options.nodeAPI) ? createEnvironment({ addonPath }) : createBunEnvironment();
       env.loadModule(outputPath);
       env.acquireStructures(options);
       const definition = env.exportStructures();
-      // get the absolute path to node-zigar-addon so the transpiled code can find it
-      const runtimeURL = pathToFileURL(getLibraryPath()).href;
+      // get the absolute path to the runtime so the transpiled code can find it
+      const runtimeURL = (options.nodeAPI)
+      ? pathToFileURL(getLibraryPath()).href
+      : new URL('./runtime.js', import.meta.url).href;
       const binarySource = env.hasMethods() ? JSON.stringify(outputPath) : undefined;
-      const envOptions = { addonPath };
+      const envOptions = (options.nodeAPI) ? { addonPath } : undefined;
       const { code } = generateCode(definition, { runtimeURL, binarySource, envOptions });
       return {
         contents: code,
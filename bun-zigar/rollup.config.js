@@ -0,0 +1,36 @@
+import { readFileSync } from 'fs';
+import StripCode from 'rollup-plugin-strip-code';
+
+export default {
+  input: 'src/runtime.js',
+  external: [ 'bun:ffi', 'url' ],
+  plugins: [
+    StripCode({
+      start_comment: 'OVERRIDDEN',
+      end_comment: 'OVERRIDDEN-END'
+    }),
+    StripCode({
+      start_comment: 'DEV-TEST',
+      end_comment: 'DEV-TEST-END'
+    }),
+    StripCode({
+      start_comment: 'WASM-ONLY',
+      end_comment: 'WASM-ONLY-END'
+    }),
+    {
+      // the C shim is compiled by bun:ffi at runtime, from a path relative to the bundle
+      name: 'C shim',
+      generateBundle() {
+        this.emitFile({
+          type: 'asset',
+          fileName: 'environment-bun.c',
+          source: readFileSync('../zigar-runtime/src/environment-bun.c', 'utf8'),
+        });
+      },
+    },
+  ],
+  output: {
+    file: 'dist/runtime.js',
+    format: 'esm',
+  },
+};
@@ -0,0 +1,12 @@
+import { useAllExtendedTypes } from '../../zigar-runtime/src/data-view.js';
+import { BunEnvironment } from '../../zigar-runtime/src/environment-bun.js';
+import { useAllMemberTypes } from '../../zigar-runtime/src/member.js';
+import { useAllStructureTypes } from '../../zigar-runtime/src/structure.js';
+
+useAllMemberTypes();
+useAllStructureTypes();
+useAllExtendedTypes();
+
+export function createEnvironment() {
+  return new BunEnvironment();
+}
@@ -1,7 +1,8 @@
 const { execFileSync, execFile: execFileAsync } = require('child_process');
 const { promisify } = require('util');
 const execFile = promisify(execFileAsync);
-const { stat, readdir } = require('fs/promises');
+const { createHash } = require('crypto');
+const { stat, readdir, readFile, writeFile } = require('fs/promises');
 const { writeFileSync } = require('fs');
 const os = require('os');
 const { join, resolve } = require('path');
@@ -77,20 +78,28 @@ async function buildAddon(addonDir, options) {
       } catch (err) {
       }
     };
-    const getSourceMTime = async () => {
-      const srcDir = join(baseDir, 'src');
+    // compare content of source files instead of mtimes, which don't survive fresh checkouts
+    const getSourceHash = async () => {
       try {
-        const stats = await getDirectoryStats(srcDir);
-        return stats.mtimeMs;
+        const hash = createHash('md5');
+        hash.update(args.join(' '));
+        await hashDirectory(hash, join(baseDir, 'src'));
+        hash.update(await readFile(join(baseDir, 'build.zig')));
+        return hash.digest('hex');
         /* c8 ignore next 2 */
       } catch (err) {
       }
     };
+    const hashPath = `${outputPath}.md5`;
     const outputMTimeBefore = await getOutputMTime();
-    const sourceMTime = await getSourceMTime();
-    if (!outputMTimeBefore || outputMTimeBefore < sourceMTime) {
+    const sourceHash = await getSourceHash();
+    const outputHash = await readFile(hashPath, 'utf8').catch(() => undefined);
+    if (!outputMTimeBefore || !sourceHash || outputHash !== sourceHash) {
       try {
         await runCompiler(zigPath, args, { cwd: baseDir, onStart, onEnd });
+        if (sourceHash) {
+          await writeFile(hashPath, sourceHash);
+        }
       } catch (err) {
         if (err.code === 'ENOENT') {
           if (!outputMTimeBefore) {
@@ -143,23 +152,18 @@ function getArch() {
   return os.arch();
 }
 
-async function getDirectoryStats(dirPath) {
-  let size = 0, mtimeMs = 0;
-  const names = await readdir(dirPath);
+async function hashDirectory(hash, dirPath) {
+  const names = (await readdir(dirPath)).sort();
   for (const name of names) {
     const path = join(dirPath, name);
-    let info = await stat(path);
-    if(info.isDirectory()) {
-      info = await getDirectoryStats(path);
-    } else if (!info.isFile()) {
-      continue;
-    }
-    size += info.size;
-    if (mtimeMs < info.mtimeMs) {
-      mtimeMs = info.mtimeMs;
+    const info = await stat(path);
+    if (info.isDirectory()) {
+      await hashDirectory(hash, path);
+    } else if (info.isFile()) {
+      hash.update(`\n${name}\n`);
+      hash.update(await readFile(path));
     }
   }
-  return { size, mtimeMs };
 }
 
 async function runCompiler(path, args, options) {
@@ -3,11 +3,82 @@
 int module_count = 0;
 int buffer_count = 0;
 int function_count = 0;
+int callback_count = 0;
+int mapping_count = 0;
+
+// thread pool shared by all modules; it's created by the first module that needs it
+thread_pool shared_pool = { NULL, NULL };
+size_t shared_pool_size = 0;
 
 void reference_module(module_data* md) {
     md->ref_count++;
 }
 
+double get_time_ms() {
+#ifdef WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart * 1000.0 / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+#endif
+}
+
+void redirect_module_io(module_data* md) {
+    double start = get_time_ms();
+    redirect_io_functions(md->so_handle, md->so_path, md->mod->imports->override_write);
+    md->profile.redirect = get_time_ms() - start;
+    free(md->so_path);
+    md->so_path = NULL;
+}
+
+#ifdef WIN32
+DWORD WINAPI run_redirect_thread(LPVOID arg) {
+    redirect_module_io((module_data*) arg);
+    return 0;
+}
+#else
+void* run_redirect_thread(void* arg) {
+    redirect_module_io((module_data*) arg);
+    return NULL;
+}
+#endif
+
+bool start_redirect_thread(module_data* md) {
+#ifdef WIN32
+    HANDLE handle = CreateThread(NULL, 0, run_redirect_thread, md, 0, NULL);
+    if (!handle) {
+        return false;
+    }
+    md->redirect_thread = handle;
+#else
+    if (pthread_create(&md->redirect_thread, NULL, run_redirect_thread, md) != 0) {
+        return false;
+    }
+#endif
+    md->redirect_thread_active = true;
+    return true;
+}
+
+void complete_redirect(module_data* md) {
+    // must be called before any code in the shared library gets to run
+    if (md->redirect_thread_active) {
+#ifdef WIN32
+        WaitForSingleObject(md->redirect_thread, INFINITE);
+        CloseHandle(md->redirect_thread);
+#else
+        pthread_join(md->redirect_thread, NULL);
+#endif
+        md->redirect_thread_active = false;
+    } else if (md->redirect_pending) {
+        redirect_module_io(md);
+    }
+    md->redirect_pending = false;
+}
+
 module_data* new_module(napi_env env) {
     module_data* md = (module_data*) calloc(1, sizeof(module_data));
     md->ref_count = 0;
@@ -26,9 +97,13 @@ void release_module(napi_env env,
             // indicate to the environment that the shared lib has been released
             napi_set_named_property(env, js_env, "released", released);
         }
+        if (md->redirect_thread_active) {
+            complete_redirect(md);
+        }
         if (md->so_handle) {
             dlclose(md->so_handle);
         }
+        free(md->so_path);
         free(md);
         module_count--;
     }
@@ -328,6 +403,53 @@ result write_to_console(call ctx,
     return FAILURE;
 }
 
+result queue_callback(uintptr_t handle,
+                      const void* bytes,
+                      size_t len) {
+    // this can be called from any thread--the arguments are copied and the call is
+    // placed in the queue of the thread-safe function
+    js_callback* cb = (js_callback*) handle;
+    js_callback_call* call = (js_callback_call*) malloc(sizeof(js_callback_call) + len);
+    if (!call) {
+        return FAILURE;
+    }
+    call->len = len;
+    memcpy(call->bytes, bytes, len);
+    if (napi_call_threadsafe_function(cb->tsfn, call, napi_tsfn_blocking) != napi_ok) {
+        // function has been released
+        free(call);
+        return FAILURE;
+    }
+    return OK;
+}
+
+result get_thread_pool(call ctx,
+                        thread_pool* dest) {
+    if (!shared_pool.ptr) {
+        // the pool runs code from the module creating it, so the shared library needs to stay
+        // loaded for as long as the pool exists
+        module_data* md = ctx->mod_data;
+        if (md->mod->imports->create_thread_pool(shared_pool_size, &shared_pool) != OK) {
+            return FAILURE;
+        }
+        reference_module(md);
+    }
+    *dest = shared_pool;
+    return OK;
+}
+
+void retire_thread_pool(napi_env env) {
+    if (shared_pool.ptr) {
+        // tasks still in the queues are run before the threads exit; the pool itself is never
+        // freed, since Zig code might still be holding onto it, and a retired pool simply runs
+        // tasks spawned on it in the calling thread; for the same reason the module whose code
+        // it runs is kept loaded
+        shared_pool.vtable->shut_down(shared_pool.ptr);
+        shared_pool.ptr = NULL;
+        shared_pool.vtable = NULL;
+    }
+}
+
 napi_value throw_error(napi_env env,
                        const char *err_message) {
     napi_value last;
@@ -347,10 +469,20 @@ napi_value get_buffer_address(napi_env env,
     size_t argc = 1;
     napi_value args[1];
     void* bytes;
+    bool is_dataview;
+    size_t byte_offset;
     // check arguments
-    if (napi_get_cb_info(env, info, &argc, &args[0], NULL, NULL) != napi_ok
-     || napi_get_arraybuffer_info(env, args[0], &bytes, NULL) != napi_ok) {
-        return throw_error(env, "Argument must be ArrayBuffer");
+    if (napi_get_cb_info(env, info, &argc, &args[0], NULL, NULL) != napi_ok) {
+        return throw_last_error(env);
+    }
+    if (napi_get_arraybuffer_info(env, args[0], &bytes, NULL) != napi_ok) {
+        // Node-API does not accept SharedArrayBuffer, so we get its address through a view
+        if (napi_is_dataview(env, args[0], &is_dataview) != napi_ok
+         || !is_dataview
+         || napi_get_dataview_info(env, args[0], NULL, &bytes, NULL, &byte_offset) != napi_ok) {
+            return throw_error(env, "Argument must be ArrayBuffer or DataView");
+        }
+        bytes = (uint8_t*) bytes - byte_offset;
     }
     napi_value address;
     if (napi_create_uintptr(env, (uintptr_t) bytes, &address) != napi_ok) {
@@ -450,6 +582,251 @@ napi_value obtain_external_buffer(napi_env env,
     return buffer;
 }
 
+#ifdef WIN32
+const char* map_file_memory(const char* path,
+                            bool writable,
+                            uint32_t access,
+                            mapped_file* mf) {
+    wchar_t* wpath;
+    int wlen = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+    if (!wlen || !(wpath = malloc(wlen * sizeof(wchar_t)))) {
+        return "Invalid path";
+    }
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, wlen);
+    // access pattern can only be specified when the file is opened
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (access == ACCESS_SEQUENTIAL) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (access == ACCESS_RANDOM) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    DWORD file_access = GENERIC_READ | (writable ? GENERIC_WRITE : 0);
+    HANDLE file = CreateFileW(wpath, file_access, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, flags, NULL);
+    free(wpath);
+    if (file == INVALID_HANDLE_VALUE) {
+        return "Unable to open file";
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return "Unable to obtain file size";
+    }
+    mf->len = (size_t) size.QuadPart;
+    if (mf->len > 0) {
+        // pages of a read-only mapping are copied on write, so JavaScript writing into them
+        // doesn't crash the process
+        HANDLE mapping = CreateFileMappingW(file, NULL, writable ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, NULL);
+        if (mapping) {
+            mf->bytes = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, 0);
+            // the view keeps the mapping alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    if (mf->len > 0 && !mf->bytes) {
+        return "Unable to map file into memory";
+    }
+    return NULL;
+}
+
+void unmap_file_memory(mapped_file* mf) {
+    UnmapViewOfFile(mf->bytes);
+    mf->unmapped = true;
+}
+
+bool advise_memory_access(void* bytes,
+                          size_t len,
+                          uint32_t access) {
+    // hints are given when the file is opened instead
+    return true;
+}
+#else
+bool advise_memory_access(void* bytes,
+                          size_t len,
+                          uint32_t access) {
+    int advice;
+    switch (access) {
+        case ACCESS_NORMAL: advice = MADV_NORMAL; break;
+        case ACCESS_SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+        case ACCESS_RANDOM: advice = MADV_RANDOM; break;
+        case ACCESS_WILL_NEED: advice = MADV_WILLNEED; break;
+        case ACCESS_DONT_NEED: advice = MADV_DONTNEED; break;
+        default: return false;
+    }
+    uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t) bytes;
+    uintptr_t end = start + len;
+    if (access == ACCESS_DONT_NEED) {
+        // pages are discarded along with changes made to a private mapping, so only those lying
+        // entirely within the range can be given up
+        start = (start + page_size - 1) & ~(page_size - 1);
+        end &= ~(page_size - 1);
+        if (end <= start) {
+            return true;
+        }
+    } else {
+        // madvise() wants an address on a page boundary
+        start &= ~(page_size - 1);
+    }
+    return madvise((void*) start, end - start, advice) == 0;
+}
+
+const char* map_file_memory(const char* path,
+                            bool writable,
+                            uint32_t access,
+                            mapped_file* mf) {
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd == -1) {
+        return "Unable to open file";
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return "Unable to obtain file size";
+    }
+    mf->len = st.st_size;
+    if (mf->len > 0) {
+        // pages of a read-only mapping are copied on write, so JavaScript writing into them
+        // doesn't crash the process
+        void* bytes = mmap(NULL, mf->len, PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+        mf->bytes = (bytes != MAP_FAILED) ? bytes : NULL;
+    }
+    // the mapping remains valid after the file is closed
+    close(fd);
+    if (mf->len > 0) {
+        if (!mf->bytes) {
+            return "Unable to map file into memory";
+        }
+        if (access != ACCESS_NORMAL) {
+            advise_memory_access(mf->bytes, mf->len, access);
+        }
+    }
+    return NULL;
+}
+
+void unmap_file_memory(mapped_file* mf) {
+    munmap(mf->bytes, mf->len);
+    mf->unmapped = true;
+}
+#endif
+
+void finalize_mapped_file(napi_env env,
+                          void* finalize_data,
+                          void* finalize_hint) {
+    mapped_file* mf = (mapped_file*) finalize_hint;
+    if (!mf->unmapped) {
+        unmap_file_memory(mf);
+    }
+    free(mf);
+    mapping_count--;
+}
+
+napi_value map_file(napi_env env,
+                    napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    size_t path_len;
+    bool writable;
+    uint32_t access;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_get_value_string_utf8(env, args[0], NULL, 0, &path_len) != napi_ok) {
+        return throw_error(env, "Path must be string");
+    } else if (napi_get_value_bool(env, args[1], &writable) != napi_ok) {
+        return throw_error(env, "Writable must be boolean");
+    } else if (napi_get_value_uint32(env, args[2], &access) != napi_ok) {
+        return throw_error(env, "Access must be number");
+    }
+    char* path = malloc(path_len + 1);
+    mapped_file* mf = calloc(1, sizeof(mapped_file));
+    if (!path || !mf) {
+        free(path);
+        free(mf);
+        return throw_error(env, "Out of memory");
+    }
+    napi_get_value_string_utf8(env, args[0], path, path_len + 1, &path_len);
+    const char* error = map_file_memory(path, writable, access, mf);
+    free(path);
+    if (error) {
+        free(mf);
+        return throw_error(env, error);
+    }
+    napi_value buffer;
+    if (mf->len == 0) {
+        // nothing was mapped for an empty file
+        free(mf);
+        if (napi_create_arraybuffer(env, 0, NULL, &buffer) != napi_ok) {
+            return throw_last_error(env);
+        }
+        return buffer;
+    }
+    napi_status status = napi_create_external_arraybuffer(env, mf->bytes, mf->len, finalize_mapped_file, mf, &buffer);
+    if (status != napi_ok) {
+        // copying the file into memory would defeat the purpose of mapping it
+        unmap_file_memory(mf);
+        free(mf);
+        return (status == napi_no_external_buffers_allowed)
+            ? throw_error(env, "External buffers are not allowed")
+            : throw_last_error(env);
+    }
+    mapping_count++;
+    // attach the mapping to the buffer so unmap_file() can find it; the finalizer above frees it
+    if (napi_wrap(env, buffer, mf, NULL, NULL, NULL) != napi_ok) {
+        return throw_last_error(env);
+    }
+    return buffer;
+}
+
+napi_value unmap_file(napi_env env,
+                      napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    mapped_file* mf;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_unwrap(env, args[0], (void**) &mf) != napi_ok) {
+        return throw_error(env, "Argument must be a buffer of a mapped file");
+    }
+    if (!mf->unmapped) {
+        // unmap before detaching, since the finalizer might run as a result and free the struct
+        unmap_file_memory(mf);
+        // detach the buffer so that it can no longer be used to access the memory
+        if (napi_detach_arraybuffer(env, args[0]) != napi_ok) {
+            return throw_last_error(env);
+        }
+    }
+    return NULL;
+}
+
+napi_value advise_memory(napi_env env,
+                         napi_callback_info info) {
+    size_t argc = 4;
+    napi_value args[4];
+    mapped_file* mf;
+    double offset;
+    double len;
+    uint32_t access;
+    // only memory of mapped files can be given hints, since some (e.g. "don't need") would
+    // wipe out the contents of regular memory
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_unwrap(env, args[0], (void**) &mf) != napi_ok) {
+        return throw_error(env, "Argument must be a buffer of a mapped file");
+    } else if (napi_get_value_double(env, args[1], &offset) != napi_ok) {
+        return throw_error(env, "Offset must be number");
+    } else if (napi_get_value_double(env, args[2], &len) != napi_ok) {
+        return throw_error(env, "Length must be number");
+    } else if (napi_get_value_uint32(env, args[3], &access) != napi_ok) {
+        return throw_error(env, "Access must be number");
+    }
+    if (mf->unmapped) {
+        return throw_error(env, "File has been unmapped");
+    } else if (offset < 0 || len < 0 || offset + len > mf->len) {
+        return throw_error(env, "Range is outside of mapped file");
+    }
+    if (len > 0 && !advise_memory_access((uint8_t*) mf->bytes + (size_t) offset, len, access)) {
+        return throw_error(env, "Unable to give access hint");
+    }
+    return NULL;
+}
+
 napi_value copy_bytes(napi_env env,
                       napi_callback_info info) {
     size_t argc = 3;
@@ -511,12 +888,77 @@ napi_value find_sentinel(napi_env env,
     return NULL;
 }
 
+napi_value create_string(napi_env env,
+                          napi_callback_info info) {
+    size_t argc = 3;
+    napi_value args[3];
+    uintptr_t address;
+    double len;
+    uint32_t char_size;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_get_value_uintptr(env, args[0], &address) != napi_ok) {
+        return throw_error(env, "Address must be "UINTPTR_JS_TYPE);
+    } else if (napi_get_value_double(env, args[1], &len) != napi_ok) {
+        return throw_error(env, "Length must be number");
+    } else if (napi_get_value_uint32(env, args[2], &char_size) != napi_ok) {
+        return throw_error(env, "Character size must be number");
+    }
+    // decode directly from Zig memory, without going through an external buffer
+    napi_value string;
+    napi_status status = (char_size == 2)
+    ? napi_create_string_utf16(env, (const char16_t*) address, len, &string)
+    : napi_create_string_utf8(env, (const char*) address, len, &string);
+    if (status != napi_ok) {
+        return throw_last_error(env);
+    }
+    return string;
+}
+
+napi_value encode_string(napi_env env,
+                         napi_callback_info info) {
+    size_t argc = 2;
+    napi_value args[2];
+    uint32_t char_size;
+    size_t len;
+    napi_valuetype type;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_typeof(env, args[0], &type) != napi_ok
+     || type != napi_string) {
+        return throw_error(env, "Argument must be string");
+    } else if (napi_get_value_uint32(env, args[1], &char_size) != napi_ok) {
+        return throw_error(env, "Character size must be number");
+    }
+    // obtain the length first so the buffer can be sized exactly
+    napi_status status = (char_size == 2)
+    ? napi_get_value_string_utf16(env, args[0], NULL, 0, &len)
+    : napi_get_value_string_utf8(env, args[0], NULL, 0, &len);
+    if (status != napi_ok) {
+        return throw_last_error(env);
+    }
+    // N-API always writes a terminating zero, hence the extra character
+    napi_value buffer, dv;
+    void* dest;
+    size_t copied;
+    if (napi_create_arraybuffer(env, (len + 1) * char_size, &dest, &buffer) != napi_ok) {
+        return throw_last_error(env);
+    }
+    status = (char_size == 2)
+    ? napi_get_value_string_utf16(env, args[0], (char16_t*) dest, len + 1, &copied)
+    : napi_get_value_string_utf8(env, args[0], (char*) dest, len + 1, &copied);
+    if (status != napi_ok
+     || napi_create_dataview(env, copied * char_size, buffer, 0, &dv) != napi_ok) {
+        return throw_last_error(env);
+    }
+    return dv;
+}
+
 napi_value get_factory_thunk(napi_env env,
                              napi_callback_info info) {
     module_data* md;
     if (napi_get_cb_info(env, info, NULL, NULL, NULL, (void*) &md) != napi_ok) {
         return throw_last_error(env);
     }
+    complete_redirect(md);
     size_t thunk_address;
     if (md->mod->imports->get_factory_thunk(&thunk_address) != OK) {
         return throw_error(env, "Unable to define structures");
@@ -551,6 +993,7 @@ napi_value run_thunk(napi_env env,
         // pointer might not be valid when length is zero
         args_ptr = NULL;
     }
+    complete_redirect(md);
     if (md->mod->imports->run_thunk(&ctx, thunk_address, args_ptr, &result) != OK) {
         return throw_error(env, "Unable to execute function");
     }
@@ -586,6 +1029,7 @@ napi_value run_variadic_thunk(napi_env env,
     if (args_len == 0) {
         args_ptr = NULL;
     }
+    complete_redirect(md);
     if (md->mod->imports->run_variadic_thunk(&ctx, thunk_address, args_ptr, args_attrs_ptr, arg_count, &result) != OK) {
         return throw_error(env, "Unable to execute function");
     }
@@ -635,6 +1079,177 @@ napi_value recreate_address(napi_env env,
     return address;
 }
 
+void call_js_callback(napi_env env,
+                      napi_value js_cb,
+                      void* context,
+                      void* data) {
+    // invoked on the JS thread, in the order in which calls were queued
+    js_callback_call* call = (js_callback_call*) data;
+    if (env != NULL) {
+        void* bytes;
+        napi_value buffer, dv, recv, result;
+        if (napi_create_arraybuffer(env, call->len, &bytes, &buffer) == napi_ok
+         && napi_create_dataview(env, call->len, buffer, 0, &dv) == napi_ok
+         && napi_get_undefined(env, &recv) == napi_ok) {
+            memcpy(bytes, call->bytes, call->len);
+            if (napi_call_function(env, recv, js_cb, 1, &dv, &result) == napi_pending_exception) {
+                // report error thrown by the JS function as an uncaught exception
+                napi_value error;
+                napi_get_and_clear_last_exception(env, &error);
+                napi_fatal_exception(env, error);
+            }
+        }
+    }
+    free(call);
+}
+
+void finalize_js_callback(napi_env env,
+                          void* finalize_data,
+                          void* finalize_hint) {
+    free(finalize_data);
+    callback_count--;
+}
+
+napi_value create_js_callback(napi_env env,
+                              napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    napi_valuetype type;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_typeof(env, args[0], &type) != napi_ok
+     || type != napi_function) {
+        return throw_error(env, "Argument must be a function");
+    }
+    js_callback* cb = (js_callback*) calloc(1, sizeof(js_callback));
+    napi_value name;
+    // the queue has no size limit, so calls from the JS thread itself would never block
+    if (napi_create_string_utf8(env, "zigar-callback", NAPI_AUTO_LENGTH, &name) != napi_ok
+     || napi_create_threadsafe_function(env, args[0], NULL, name, 0, 1, cb, finalize_js_callback, NULL, call_js_callback, &cb->tsfn) != napi_ok) {
+        free(cb);
+        return throw_error(env, "Unable to create thread-safe function");
+    }
+    callback_count++;
+    napi_value handle;
+    if (napi_create_uintptr(env, (uintptr_t) cb, &handle) != napi_ok) {
+        return throw_last_error(env);
+    }
+    return handle;
+}
+
+napi_value release_js_callback(napi_env env,
+                               napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    uintptr_t handle;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_get_value_uintptr(env, args[0], &handle) != napi_ok) {
+        return throw_error(env, "Handle must be "UINTPTR_JS_TYPE);
+    }
+    js_callback* cb = (js_callback*) handle;
+    // the handle has been detached from its trampoline, which waits for calls that have already
+    // read it to be queued, so no thread can use cb after this point; calls already in the queue
+    // are still delivered and the struct is freed by finalize_js_callback()
+    if (napi_release_threadsafe_function(cb->tsfn, napi_tsfn_release) != napi_ok) {
+        return throw_last_error(env);
+    }
+    return NULL;
+}
+
+napi_value set_thread_count(napi_env env,
+                            napi_callback_info info) {
+    size_t argc = 1;
+    napi_value args[1];
+    uint32_t count;
+    if (napi_get_cb_info(env, info, &argc, args, NULL, NULL) != napi_ok
+     || napi_get_value_uint32(env, args[0], &count) != napi_ok) {
+        return throw_error(env, "Thread count must be a number");
+    }
+    if (shared_pool.ptr && (count == 0 || shared_pool.vtable->get_thread_count(shared_pool.ptr) != count)) {
+        thread_pool_stats ps;
+        shared_pool.vtable->get_stats(shared_pool.ptr, &ps);
+        if (ps.pending > 0 || ps.active > 0) {
+            return throw_error(env, "Thread pool cannot be resized while it is busy");
+        }
+        // pool will get recreated with the new size when it's needed again
+        retire_thread_pool(env);
+    }
+    shared_pool_size = count;
+    return NULL;
+}
+
+napi_value get_thread_pool_stats(napi_env env,
+                                 napi_callback_info info) {
+    napi_value stats;
+    if (!shared_pool.ptr) {
+        napi_get_null(env, &stats);
+        return stats;
+    }
+    thread_pool_stats ps;
+    shared_pool.vtable->get_stats(shared_pool.ptr, &ps);
+    napi_value threads, submitted, completed, stolen, pending, sleeps, active;
+    bool success = napi_create_object(env, &stats) == napi_ok
+                && napi_create_double(env, ps.thread_count, &threads) == napi_ok
+                && napi_set_named_property(env, stats, "threads", threads) == napi_ok
+                && napi_create_double(env, ps.submitted, &submitted) == napi_ok
+                && napi_set_named_property(env, stats, "submitted", submitted) == napi_ok
+                && napi_create_double(env, ps.completed, &completed) == napi_ok
+                && napi_set_named_property(env, stats, "completed", completed) == napi_ok
+                && napi_create_double(env, ps.stolen, &stolen) == napi_ok
+                && napi_set_named_property(env, stats, "stolen", stolen) == napi_ok
+                && napi_create_double(env, ps.pending, &pending) == napi_ok
+                && napi_set_named_property(env, stats, "pending", pending) == napi_ok
+                && napi_create_double(env, ps.sleeps, &sleeps) == napi_ok
+                && napi_set_named_property(env, stats, "sleeps", sleeps) == napi_ok
+                && napi_create_double(env, ps.active, &active) == napi_ok
+                && napi_set_named_property(env, stats, "active", active) == napi_ok;
+    if (!success) {
+        return throw_last_error(env);
+    }
+    return stats;
+}
+
+bool set_profile_time(napi_env env,
+                      napi_value object,
+                      const char* name,
+                      double ms) {
+    napi_value value;
+    return napi_create_double(env, ms, &value) == napi_ok
+        && napi_set_named_property(env, object, name, value) == napi_ok;
+}
+
+napi_value get_load_profile(napi_env env,
+                            napi_callback_info info) {
+    module_data* md;
+    if (napi_get_cb_info(env, info, NULL, NULL, NULL, (void*) &md) != napi_ok) {
+        return throw_last_error(env);
+    }
+    load_profile* profile = &md->profile;
+    napi_value result;
+    if (!profile->enabled) {
+        napi_get_null(env, &result);
+        return result;
+    }
+    bool success = napi_create_object(env, &result) == napi_ok
+                && set_profile_time(env, result, "dlopen", profile->dlopen)
+                && set_profile_time(env, result, "dlsym", profile->dlsym)
+                && set_profile_time(env, result, "dladdr", profile->dladdr)
+                && set_profile_time(env, result, "patch", profile->patch);
+    if (success) {
+        // time spent on redirection is only known once it has happened
+        if (md->redirect_pending) {
+            napi_value redirect;
+            success = napi_get_null(env, &redirect) == napi_ok
+                   && napi_set_named_property(env, result, "redirect", redirect) == napi_ok;
+        } else {
+            success = set_profile_time(env, result, "redirect", profile->redirect);
+        }
+    }
+    if (!success) {
+        return throw_last_error(env);
+    }
+    return result;
+}
+
 void finalize_function(napi_env env,
                        void* finalize_data,
                        void* finalize_hint) {
@@ -671,67 +1286,139 @@ bool export_module_functions(napi_env env,
         && export_function(env, js_env, "obtainExternBuffer", obtain_external_buffer, md)
         && export_function(env, js_env, "copyBytes", copy_bytes, md)
         && export_function(env, js_env, "findSentinel", find_sentinel, md)
+        && export_function(env, js_env, "createString", create_string, md)
+        && export_function(env, js_env, "encodeString", encode_string, md)
         && export_function(env, js_env, "getFactoryThunk", get_factory_thunk, md)
         && export_function(env, js_env, "runThunk", run_thunk, md)
         && export_function(env, js_env, "runVariadicThunk", run_variadic_thunk, md)
         && export_function(env, js_env, "getMemoryOffset", get_memory_offset, md)
-        && export_function(env, js_env, "recreateAddress", recreate_address, md);
+        && export_function(env, js_env, "recreateAddress", recreate_address, md)
+        && export_function(env, js_env, "createJsCallback", create_js_callback, md)
+        && export_function(env, js_env, "releaseJsCallback", release_js_callback, md)
+        && export_function(env, js_env, "setThreadCount", set_thread_count, md)
+        && export_function(env, js_env, "getThreadPoolStats", get_thread_pool_stats, md)
+        && export_function(env, js_env, "getLoadProfile", get_load_profile, md)
+        && export_function(env, js_env, "mapFile", map_file, md)
+        && export_function(env, js_env, "unmapFile", unmap_file, md)
+        && export_function(env, js_env, "adviseMemory", advise_memory, md);
+}
+
+bool are_external_buffers_allowed(napi_env env) {
+    // when they aren't, obtain_external_buffer() returns copies, which can't stand in for the
+    // memory at other addresses
+    static char byte;
+    napi_value buffer;
+    return napi_create_external_arraybuffer(env, &byte, 1, NULL, NULL, &buffer) != napi_no_external_buffers_allowed;
 }
 
 bool set_module_attributes(napi_env env,
                            module_data* md) {
     module_attributes attributes = md->mod->attributes;
-    napi_value little_endian, runtime_safety;
+    napi_value little_endian, runtime_safety, external_buffers;
     napi_value js_env;
     return napi_get_reference_value(env, md->js_env, &js_env) == napi_ok
         && js_env != NULL
         && napi_get_boolean(env, attributes.little_endian, &little_endian) == napi_ok
         && napi_set_named_property(env, js_env, "littleEndian", little_endian) == napi_ok
         && napi_get_boolean(env, attributes.runtime_safety, &runtime_safety) == napi_ok
-        && napi_set_named_property(env, js_env, "runtimeSafety", runtime_safety) == napi_ok;
+        && napi_set_named_property(env, js_env, "runtimeSafety", runtime_safety) == napi_ok
+        && napi_get_boolean(env, are_external_buffers_allowed(env), &external_buffers) == napi_ok
+        && napi_set_named_property(env, js_env, "externalBuffers", external_buffers) == napi_ok;
+}
+
+bool get_boolean_option(napi_env env,
+                        napi_value options,
+                        const char* name) {
+    napi_value value;
+    bool result = false;
+    napi_valuetype type;
+    if (napi_typeof(env, options, &type) == napi_ok
+     && type == napi_object
+     && napi_get_named_property(env, options, name, &value) == napi_ok) {
+        napi_get_value_bool(env, value, &result);
+    }
+    return result;
+}
+
+int get_redirect_option(napi_env env,
+                        napi_value options) {
+    napi_value value;
+    char buffer[16] = "";
+    size_t len;
+    napi_valuetype type;
+    if (napi_typeof(env, options, &type) == napi_ok
+     && type == napi_object
+     && napi_get_named_property(env, options, "ioRedirect", &value) == napi_ok) {
+        napi_get_value_string_utf8(env, value, buffer, sizeof(buffer), &len);
+    }
+    if (strcmp(buffer, "deferred") == 0) {
+        return REDIRECT_DEFERRED;
+    } else if (strcmp(buffer, "background") == 0) {
+        return REDIRECT_BACKGROUND;
+    }
+    return REDIRECT_NOW;
 }
 
 napi_value load_module(napi_env env,
                        napi_callback_info info) {
     module_data* md;
-    size_t argc = 1;
+    size_t argc = 2;
     size_t path_len;
-    napi_value args[1];
+    napi_value args[2];
     // check arguments
     if (napi_get_cb_info(env, info, &argc, args, NULL, (void*) &md) != napi_ok
      || napi_get_value_string_utf8(env, args[0], NULL, 0, &path_len) != napi_ok) {
         return throw_error(env, "Invalid arguments");
     }
+    // options are optional
+    napi_value options = (argc > 1) ? args[1] : NULL;
+    bool lazy_binding = options && get_boolean_option(env, options, "lazyBinding");
+    int redirect = options ? get_redirect_option(env, options) : REDIRECT_NOW;
+    load_profile* profile = &md->profile;
+    profile->enabled = options && get_boolean_option(env, options, "profile");
 
-    // load the shared library
-    char* path = malloc(path_len + 1);
+    // load the shared library; with lazy binding, symbols are resolved on first use instead
+    // of all at once
+    char* path = md->so_path = malloc(path_len + 1);
     napi_get_value_string_utf8(env, args[0], path, path_len + 1, &path_len);
-    void* handle = md->so_handle = dlopen(path, RTLD_NOW);
+    double time = get_time_ms();
+    void* handle = md->so_handle = dlopen(path, lazy_binding ? RTLD_LAZY : RTLD_NOW);
+    profile->dlopen = get_time_ms() - time;
     if (!handle) {
         return throw_error(env, "Unable to load shared library");
     }
 
     // find the zig module
+    time = get_time_ms();
     void* symbol = dlsym(handle, "zig_module");
+    profile->dlsym = get_time_ms() - time;
     if (!symbol) {
         return throw_error(env, "Unable to find the symbol \"zig_module\"");
     }
     module* mod = md->mod = (module*) symbol;
-    if (mod->version != 4) {
+    if (mod->version != 6) {
         return throw_error(env, "Cached module is compiled for a different version of Zigar");
     }
 
     // set base address
     Dl_info dl_info;
+    time = get_time_ms();
     if (!dladdr(symbol, &dl_info)) {
         return throw_error(env, "Unable to obtain address of shared library");
     }
+    profile->dladdr = get_time_ms() - time;
     md->base_address = (uintptr_t) dl_info.dli_fbase;
 
-    redirect_io_functions(handle, path, mod->imports->override_write);
-    free(path);
+    // redirect console output; since no code in the library can run before the first call,
+    // the scan can be put off until then or be performed in another thread in the meantime
+    md->redirect_pending = true;
+    if (redirect == REDIRECT_NOW
+     || (redirect == REDIRECT_BACKGROUND && !start_redirect_thread(md))) {
+        complete_redirect(md);
+    }
 
     // attach exports to module
+    time = get_time_ms();
     export_table* exports = mod->exports;
     exports->allocate_host_memory = allocate_host_memory;
     exports->free_host_memory = free_host_memory;
@@ -748,11 +1435,14 @@ napi_value load_module(napi_env env,
     exports->end_structure = end_structure;
     exports->create_template = create_template;
     exports->write_to_console = write_to_console;
+    exports->queue_callback = queue_callback;
+    exports->get_thread_pool = get_thread_pool;
 
     // add functions and attributes to environment
     if (!export_module_functions(env, md) || !set_module_attributes(env, md)) {
         return throw_error(env, "Unable to modify runtime environment");
     }
+    profile->patch = get_time_ms() - time;
     return NULL;
 }
 
@@ -814,14 +1504,18 @@ napi_value create_environment(napi_env env,
 napi_value get_gc_statistics(napi_env env,
                              napi_callback_info info) {
     napi_value stats;
-    napi_value modules, functions, buffers;
+    napi_value modules, functions, buffers, callbacks, mappings;
     bool success = napi_create_object(env, &stats) == napi_ok
                 && napi_create_int32(env, module_count, &modules) == napi_ok
                 && napi_set_named_property(env, stats, "modules", modules) == napi_ok
                 && napi_create_int32(env, function_count, &functions) == napi_ok
                 && napi_set_named_property(env, stats, "functions", functions) == napi_ok
                 && napi_create_int32(env, buffer_count, &buffers) == napi_ok
-                && napi_set_named_property(env, stats, "buffers", buffers) == napi_ok;
+                && napi_set_named_property(env, stats, "buffers", buffers) == napi_ok
+                && napi_create_int32(env, callback_count, &callbacks) == napi_ok
+                && napi_set_named_property(env, stats, "callbacks", callbacks) == napi_ok
+                && napi_create_int32(env, mapping_count, &mappings) == napi_ok
+                && napi_set_named_property(env, stats, "mappings", mappings) == napi_ok;
     if (!success) {
         return throw_last_error(env);
     }
@@ -14,9 +14,15 @@
     #include "win32-shim.h"
 #else
     #include <dlfcn.h>
+    #include <fcntl.h>
+    #include <pthread.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
 #endif
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #define MISSING(T)                      ((T) -1)
 
@@ -109,6 +115,31 @@ typedef struct {
     bool is_variadic;
 } method;
 
+typedef struct {
+    size_t thread_count;
+    size_t submitted;
+    size_t completed;
+    size_t stolen;
+    size_t pending;
+    size_t sleeps;
+    size_t active;
+} thread_pool_stats;
+
+typedef struct {
+    bool (__cdecl *spawn)(void*, void*);
+    bool (__cdecl *run_pending)(void*);
+    size_t (__cdecl *get_thread_count)(void*);
+    void* (__cdecl *allocate)(void*, size_t, size_t);
+    void (__cdecl *free)(void*, void*, size_t, size_t);
+    void (__cdecl *get_stats)(void*, thread_pool_stats*);
+    void (__cdecl *shut_down)(void*);
+} thread_pool_vtable;
+
+typedef struct {
+    void* ptr;
+    const thread_pool_vtable* vtable;
+} thread_pool;
+
 typedef struct {
     result (__cdecl *allocate_host_memory)(call, size_t, uint16_t, memory*);
     result (__cdecl *free_host_memory)(call, const memory*);
@@ -125,6 +156,8 @@ typedef struct {
     result (__cdecl *end_structure)(call, napi_value);
     result (__cdecl *create_template)(call, napi_value, napi_value*);
     result (__cdecl *write_to_console)(call, napi_value);
+    result (__cdecl *queue_callback)(uintptr_t, const void*, size_t);
+    result (__cdecl *get_thread_pool)(call, thread_pool*);
 } export_table;
 
 typedef struct {
@@ -134,6 +167,7 @@ typedef struct {
     result (__cdecl *run_thunk)(call, size_t, void*, napi_value*);
     result (__cdecl *run_variadic_thunk)(call, size_t, void*, void*, size_t, napi_value*);
     result (__cdecl *override_write)(const void*, size_t);
+    result (__cdecl *create_thread_pool)(size_t, thread_pool*);
 } import_table;
 
 typedef struct {
@@ -153,12 +187,38 @@ typedef struct {
     import_table* imports;
 } module;
 
+enum {
+    REDIRECT_NOW,
+    REDIRECT_DEFERRED,
+    REDIRECT_BACKGROUND,
+};
+
+#ifdef WIN32
+typedef HANDLE redirect_thread;
+#else
+typedef pthread_t redirect_thread;
+#endif
+
+typedef struct {
+    bool enabled;
+    double dlopen;
+    double dlsym;
+    double dladdr;
+    double redirect;
+    double patch;
+} load_profile;
+
 typedef struct {
     int ref_count;
     module *mod;
     void* so_handle;
+    char* so_path;
     uintptr_t base_address;
     napi_ref js_env;
+    bool redirect_pending;
+    bool redirect_thread_active;
+    redirect_thread redirect_thread;
+    load_profile profile;
 } module_data;
 
 typedef struct call_context {
@@ -167,6 +227,29 @@ typedef struct call_context {
     module_data *mod_data;
 } call_context;
 
+typedef struct {
+    napi_threadsafe_function tsfn;
+} js_callback;
+
+typedef struct {
+    size_t len;
+    uint8_t bytes[];
+} js_callback_call;
+
+enum {
+    ACCESS_NORMAL,
+    ACCESS_SEQUENTIAL,
+    ACCESS_RANDOM,
+    ACCESS_WILL_NEED,
+    ACCESS_DONT_NEED,
+};
+
+typedef struct {
+    void* bytes;
+    size_t len;
+    bool unmapped;
+} mapped_file;
+
 typedef struct {
     napi_ref env_constructor;
 } addon_data;
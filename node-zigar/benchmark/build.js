@@ -0,0 +1,75 @@
+import { mkdir, rm, writeFile } from 'fs/promises';
+import os from 'os';
+import { join } from 'path';
+import { performance } from 'perf_hooks';
+import { parseArgs } from 'util';
+import { compile, compileMany } from 'zigar-compiler';
+
+const { values: { optimize, count } } = parseArgs({
+  options: {
+    optimize: { type: 'string', default: 'Debug' },
+    count: { type: 'string', default: '20' },
+  },
+  strict: false,
+});
+const moduleCount = parseInt(count);
+const workDir = join(os.tmpdir(), 'zigar-build-benchmark');
+
+async function createModules(label) {
+  // give each module its own folder and source, so nothing is shared other than std
+  const modules = [];
+  for (let i = 0; i < moduleCount; i++) {
+    const dir = join(workDir, label, `module-${i}`);
+    await mkdir(dir, { recursive: true });
+    const srcPath = join(dir, `module${i}.zig`);
+    await writeFile(srcPath, [
+      `const std = @import("std");`,
+      ``,
+      `pub fn hash(bytes: []const u8) u64 {`,
+      `    return std.hash.Wyhash.hash(${i}, bytes);`,
+      `}`,
+      ``,
+      `pub fn sort(numbers: []i32) void {`,
+      `    std.mem.sort(i32, numbers, {}, std.sort.asc(i32));`,
+      `}`,
+    ].join('\n'));
+    const modPath = join(workDir, label, 'cache', `module${i}.zigar`);
+    modules.push({ srcPath, modPath });
+  }
+  return modules;
+}
+
+async function measure(label, modules, build) {
+  const options = {
+    optimize,
+    platform: os.platform(),
+    arch: os.arch(),
+    buildDir: join(workDir, label, 'build'),
+  };
+  // keep the global cache separate too, so the second case doesn't benefit from the first
+  process.env.ZIG_GLOBAL_CACHE_DIR = join(workDir, label, 'global-cache');
+  const times = [];
+  // first build, followed by one where nothing has changed
+  for (let i = 0; i < 2; i++) {
+    const start = performance.now();
+    await build(modules, options);
+    times.push(performance.now() - start);
+  }
+  console.log([
+    label.padEnd(20),
+    `${(times[0] / 1000).toFixed(2).padStart(9)} s first`,
+    `${(times[1] / 1000).toFixed(2).padStart(9)} s no-op`,
+  ].join('  '));
+}
+
+await rm(workDir, { recursive: true, force: true });
+console.log(`\nBuilding ${moduleCount} modules (${os.platform()}/${os.arch()}, ${optimize})`);
+await measure('compile() each', await createModules('separate'), async (modules, options) => {
+  for (const { srcPath, modPath } of modules) {
+    await compile(srcPath, modPath, options);
+  }
+});
+await measure('compileMany()', await createModules('multi'), async (modules, options) => {
+  await compileMany(modules, options);
+});
+await rm(workDir, { recursive: true, force: true });
@@ -0,0 +1,33 @@
+const std = @import("std");
+
+const pairs = "ATCGGCTAUAMKRYWWSSYRKMVBHDDHBVNN";
+const table = block: {
+    var t: [256]u8 = undefined;
+    for (&t, 0..) |*ptr, index| ptr.* = @truncate(index);
+    var i: usize = 0;
+    while (i < pairs.len) : (i += 2) {
+        t[pairs[i]] = pairs[i + 1];
+        t[std.ascii.toLower(pairs[i])] = pairs[i + 1];
+    }
+    break :block t;
+};
+
+pub const Complement = struct {
+    in_header: bool = false,
+};
+
+// complement nucleotides, leaving header lines as is; state is carried across chunks
+pub fn complement(state: *Complement, in: []const u8, out: []u8) usize {
+    for (in, out[0..in.len]) |c, *ptr| {
+        if (state.in_header) {
+            ptr.* = c;
+            state.in_header = c != '\n';
+        } else if (c == '>') {
+            ptr.* = c;
+            state.in_header = true;
+        } else {
+            ptr.* = table[c];
+        }
+    }
+    return in.len;
+}
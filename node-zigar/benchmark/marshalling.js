@@ -0,0 +1,9 @@
+import { getBenchmarkOptions, runBenchmarks } from '../../zigar-compiler/test/integration/benchmark.js';
+import { getBenchmarks } from '../../zigar-compiler/test/integration/marshalling/benchmarks.js';
+
+const options = getBenchmarkOptions({ platform: 'node-zigar' });
+await runBenchmarks('FFI marshalling', getBenchmarks(), importModule, options);
+
+async function importModule(url, { optimize }) {
+  return import(`${url}?optimize=${optimize}`);
+}
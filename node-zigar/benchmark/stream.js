@@ -0,0 +1,97 @@
+import { readFile } from 'fs/promises';
+import { performance } from 'perf_hooks';
+import { Readable, Transform, Writable } from 'stream';
+import { pipeline } from 'stream/promises';
+import { parseArgs } from 'util';
+import { createTransform } from '../dist/stream.js';
+
+const { values: { optimize, repeat, chunk } } = parseArgs({
+  options: {
+    optimize: { type: 'string', default: 'ReleaseFast' },
+    repeat: { type: 'string', default: '20' },
+    chunk: { type: 'string', default: '16384' },
+  },
+  strict: false,
+});
+const dataURL = new URL('../../zigar-compiler/test/integration/benchmarks-game/data/reverse-complement-250000.txt', import.meta.url);
+const data = await readFile(dataURL);
+const chunkSize = parseInt(chunk);
+const repeatCount = parseInt(repeat);
+const module = await import(`./complement.zig?optimize=${optimize}`);
+const { __zigar, complement, Complement } = module;
+
+async function measure(label, createStream) {
+  // feed the sample in chunks the size of what fs.createReadStream would give
+  const source = Readable.from((function*() {
+    for (let i = 0; i < repeatCount; i++) {
+      for (let offset = 0; offset < data.length; offset += chunkSize) {
+        yield data.subarray(offset, offset + chunkSize);
+      }
+    }
+  })(), { objectMode: false });
+  let bytes = 0;
+  const sink = new Writable({
+    write(chunk, encoding, cb) {
+      bytes += chunk.length;
+      cb();
+    },
+  });
+  globalThis.gc?.();
+  const heapBefore = process.memoryUsage().heapUsed;
+  const start = performance.now();
+  await pipeline(source, createStream(), sink);
+  const elapsed = performance.now() - start;
+  const heapDelta = process.memoryUsage().heapUsed - heapBefore;
+  const throughput = bytes / 1024 / 1024 / (elapsed / 1000);
+  console.log([
+    label.padEnd(28),
+    `${elapsed.toFixed(1).padStart(9)} ms`,
+    `${throughput.toFixed(1).padStart(9)} MB/s`,
+    `${(heapDelta / 1024 / 1024).toFixed(1).padStart(8)} MB heap`,
+  ].join('  '));
+}
+
+console.log(`\nStream throughput (${(data.length * repeatCount / 1024 / 1024).toFixed(1)} MB, ${chunkSize}-byte chunks, ${optimize})`);
+// adapter with fixed-memory buffers
+await measure('createTransform()', () => {
+  return createTransform(__zigar, complement, new Complement({}));
+});
+// calling the function directly with Node buffers
+await measure('Transform + direct call', () => {
+  const state = new Complement({});
+  return new Transform({
+    transform(chunk, encoding, cb) {
+      const out = Buffer.allocUnsafe(chunk.length);
+      const count = complement(state, chunk, out);
+      cb(null, out.subarray(0, count));
+    },
+  });
+});
+// same transform done in JavaScript
+await measure('Transform (JavaScript)', () => {
+  const table = new Uint8Array(256).map((_, i) => i);
+  const pairs = 'ATCGGCTAUAMKRYWWSSYRKMVBHDDHBVNN';
+  for (let i = 0; i < pairs.length; i += 2) {
+    table[pairs.charCodeAt(i)] = table[pairs.toLowerCase().charCodeAt(i)] = pairs.charCodeAt(i + 1);
+  }
+  let inHeader = false;
+  return new Transform({
+    transform(chunk, encoding, cb) {
+      const out = Buffer.allocUnsafe(chunk.length);
+      for (let i = 0; i < chunk.length; i++) {
+        const c = chunk[i];
+        if (inHeader) {
+          out[i] = c;
+          inHeader = c !== 0x0a;
+        } else if (c === 0x3e) {
+          out[i] = c;
+          inHeader = true;
+        } else {
+          out[i] = table[c];
+        }
+      }
+      cb(null, out);
+    },
+  });
+});
+await __zigar.abandon();
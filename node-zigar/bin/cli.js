@@ -4,7 +4,7 @@ import { writeFile } from 'fs/promises';
 import { buildAddon } from 'node-zigar-addon';
 import os from 'os';
 import { dirname, join, parse } from 'path';
-import { compile, findConfigFile, loadConfigFile, optionsForCompile } from 'zigar-compiler';
+import { compileMany, findConfigFile, loadConfigFile, optionsForCompile } from 'zigar-compiler';
 import { hideStatus, showResult, showStatus } from '../dist/status.cjs';
 
 const possiblePlatforms = [
@@ -45,21 +45,25 @@ async function buildModules() {
       }
     }
   }
-  const parentDirs = [];
-  for (const [ modPath, srcPath ] of Object.entries(config.sourceFiles)) {
-    const modName = parse(modPath).name;
-    for (const { platform, arch } of config.targets) {
-      const { changed } = await compile(srcPath, modPath, {
-        ...config,
-        platform,
-        arch,
-        onStart: () => showStatus(`Building module "${modName}" (${platform}/${arch})`),
-        onEnd: () => hideStatus(),
-        configPath,
-      });
+  const modules = Object.entries(config.sourceFiles).map(([ modPath, srcPath ]) => ({ srcPath, modPath }));
+  for (const { platform, arch } of config.targets) {
+    // all modules are built by a single instance of the compiler
+    const results = await compileMany(modules, {
+      ...config,
+      platform,
+      arch,
+      onStart: () => showStatus(`Building ${modules.length} module(s) (${platform}/${arch})`),
+      onEnd: () => hideStatus(),
+      configPath,
+    });
+    for (const [ index, { changed } ] of results.entries()) {
+      const modName = parse(modules[index].modPath).name;
       const action = (changed) ? 'Built' : 'Found';
       showResult(`${action} module "${modName}" (${platform}/${arch})`);
     }
+  }
+  const parentDirs = [];
+  for (const { modPath } of modules) {
     const parentDir = dirname(modPath);
     if (!parentDirs.includes(parentDir)) {
       parentDirs.push(parentDir);
@@ -77,10 +77,23 @@ export async function load(url, context, nextLoad) {
   const runtimeURL = pathToFileURL(getLibraryPath()).href;
   const binarySource = env.hasMethods() ? JSON.stringify(outputPath) : undefined;
   const envOptions = { addonPath };
-  const { code } = generateCode(definition, { runtimeURL, binarySource, envOptions });
+  // options affecting how the shared library gets loaded at runtime
+  const loadOptions = getLoadOptions(options);
+  const { omitTypeExports } = options;
+  const { code } = generateCode(definition, {
+    runtimeURL, binarySource, envOptions, loadOptions, omitTypeExports,
+  });
   return {
     format: 'module',
     shortCircuit: true,
     source: code,
   };
 }
+
+function getLoadOptions(options) {
+  const { lazyBinding = false, ioRedirect = 'immediate', profileStartup = false } = options;
+  if (!lazyBinding && ioRedirect === 'immediate' && !profileStartup) {
+    return;
+  }
+  return { lazyBinding, ioRedirect, profile: profileStartup };
+}
@@ -0,0 +1,195 @@
+import { Readable, Transform, Writable } from 'stream';
+
+const defaultChunkSize = 64 * 1024;
+const pools = new WeakMap();
+
+export function createTransform(zigar, fn, state, options = {}) {
+  const {
+    chunkSize = defaultChunkSize,
+    outputSize = (len) => len,
+    flush: flushAtEnd = true,
+    ...streamOptions
+  } = options;
+  const feeder = new ChunkFeeder(zigar, chunkSize);
+  const outputPool = getBufferPool(zigar, Math.max(outputSize(chunkSize), chunkSize));
+  const run = (stream, data) => {
+    const size = (data.length > 0) ? outputSize(data.length) : chunkSize;
+    // output goes into a recycled fixed buffer; only what gets pushed downstream is copied
+    const buffer = (size <= outputPool.size) ? outputPool.acquire() : null;
+    const out = (!buffer) ? zigar.allocateFixed(size, undefined, true)
+              : (size < buffer.length) ? buffer.subarray(0, size) : buffer;
+    try {
+      const count = fn(state, data, out);
+      if (count > 0) {
+        stream.push(Buffer.from(out.subarray(0, count)));
+      }
+      return count;
+    } finally {
+      if (buffer) {
+        outputPool.release(buffer);
+      }
+    }
+  };
+  return new Transform({
+    ...streamOptions,
+    transform(chunk, encoding, cb) {
+      try {
+        feeder.write(chunk, (data) => run(this, data));
+        cb();
+      } catch (err) {
+        cb(err);
+      }
+    },
+    flush(cb) {
+      try {
+        feeder.flush((data) => run(this, data));
+        if (flushAtEnd) {
+          // call the function with an empty slice until it has nothing more to give
+          while (run(this, feeder.empty) > 0);
+        }
+        cb();
+      } catch (err) {
+        cb(err);
+      } finally {
+        feeder.release();
+      }
+    },
+    destroy(err, cb) {
+      feeder.release();
+      cb(err);
+    },
+  });
+}
+
+export function createReadable(zigar, fn, state, options = {}) {
+  const {
+    chunkSize = defaultChunkSize,
+    ...streamOptions
+  } = options;
+  const pool = getBufferPool(zigar, chunkSize);
+  return new Readable({
+    ...streamOptions,
+    read() {
+      // called only when the consumer wants more data
+      const out = pool.acquire();
+      try {
+        const count = fn(state, out);
+        this.push((count > 0) ? Buffer.from(out.subarray(0, count)) : null);
+      } catch (err) {
+        this.destroy(err);
+      } finally {
+        pool.release(out);
+      }
+    },
+  });
+}
+
+export function createWritable(zigar, fn, state, options = {}) {
+  const {
+    chunkSize = defaultChunkSize,
+    flush: flushAtEnd = true,
+    ...streamOptions
+  } = options;
+  const feeder = new ChunkFeeder(zigar, chunkSize);
+  return new Writable({
+    ...streamOptions,
+    write(chunk, encoding, cb) {
+      try {
+        feeder.write(chunk, (data) => fn(state, data));
+        cb();
+      } catch (err) {
+        cb(err);
+      }
+    },
+    final(cb) {
+      try {
+        feeder.flush((data) => fn(state, data));
+        if (flushAtEnd) {
+          fn(state, feeder.empty);
+        }
+        cb();
+      } catch (err) {
+        cb(err);
+      } finally {
+        feeder.release();
+      }
+    },
+    destroy(err, cb) {
+      feeder.release();
+      cb(err);
+    },
+  });
+}
+
+class ChunkFeeder {
+  // collects incoming data in fixed memory so that Zig can access it without shadow copies
+  constructor(zigar, chunkSize) {
+    this.pool = getBufferPool(zigar, chunkSize);
+    this.buffer = null;
+    this.length = 0;
+    this.empty = this.pool.empty;
+  }
+
+  write(chunk, cb) {
+    const { length } = chunk;
+    let offset = 0;
+    while (offset < length) {
+      this.buffer ??= this.pool.acquire();
+      const { buffer } = this;
+      const count = Math.min(length - offset, buffer.length - this.length);
+      buffer.set((offset === 0 && count === length) ? chunk : chunk.subarray(offset, offset + count), this.length);
+      this.length += count;
+      offset += count;
+      if (this.length === buffer.length) {
+        this.length = 0;
+        cb(buffer);
+      }
+    }
+  }
+
+  flush(cb) {
+    if (this.length > 0) {
+      const { buffer, length } = this;
+      this.length = 0;
+      cb(buffer.subarray(0, length));
+    }
+  }
+
+  release() {
+    if (this.buffer) {
+      this.pool.release(this.buffer);
+      this.buffer = null;
+      this.length = 0;
+    }
+  }
+}
+
+function getBufferPool(zigar, size) {
+  let sizes = pools.get(zigar);
+  if (!sizes) {
+    pools.set(zigar, sizes = new Map());
+  }
+  let pool = sizes.get(size);
+  if (!pool) {
+    sizes.set(size, pool = new BufferPool(zigar, size));
+  }
+  return pool;
+}
+
+class BufferPool {
+  constructor(zigar, size) {
+    this.zigar = zigar;
+    this.size = size;
+    this.free = [];
+    this.empty = zigar.allocateFixed(0);
+  }
+
+  acquire() {
+    // memory is freed when the pool itself goes away
+    return this.free.pop() ?? this.zigar.allocateFixed(this.size, undefined, true);
+  }
+
+  release(buffer) {
+    this.free.push(buffer);
+  }
+}
@@ -0,0 +1,105 @@
+import { expect } from 'chai';
+import { Readable, Writable } from 'stream';
+import { pipeline } from 'stream/promises';
+
+import { createReadable, createTransform, createWritable } from '../dist/stream.js';
+
+describe('Stream adapters', function() {
+  let module;
+  before(async function() {
+    this.timeout(300000);
+    module = await import('./zig-samples/stream.zig');
+  })
+  describe('createTransform', function() {
+    it('should pass chunks through Zig function', async function() {
+      const { __zigar, toUpper, Upper } = module;
+      const state = new Upper({});
+      const transform = createTransform(__zigar, toUpper, state, { chunkSize: 4 });
+      const chunks = [];
+      await pipeline(
+        Readable.from([ 'hello', ' ', 'world' ]),
+        transform,
+        collect(chunks),
+      );
+      expect(Buffer.concat(chunks).toString()).to.equal('HELLO WORLD.');
+      expect(state.count).to.equal(11);
+    })
+    it('should emit copies of output written into recycled buffer', async function() {
+      const { __zigar, toUpper, Upper } = module;
+      const transform = createTransform(__zigar, toUpper, new Upper({}), { chunkSize: 5, flush: false });
+      const chunks = [];
+      await pipeline(Readable.from([ 'hello', 'world' ]), transform, collect(chunks));
+      expect(chunks).to.have.lengthOf(2);
+      expect(chunks[0]).to.be.instanceOf(Uint8Array);
+      // the second call reused the buffer holding the output of the first
+      expect(chunks.map(c => Buffer.from(c).toString())).to.eql([ 'HELLO', 'WORLD' ]);
+    })
+    it('should propagate error from Zig function', async function() {
+      const { __zigar, toUpper, Upper } = module;
+      const transform = createTransform(__zigar, toUpper, new Upper({}));
+      let error;
+      try {
+        await pipeline(Readable.from([ 'hello', '!' ]), transform, collect([]));
+      } catch (err) {
+        error = err;
+      }
+      expect(error).to.be.an('error').with.property('message', 'Exclamation');
+    })
+    it('should respect backpressure from downstream', async function() {
+      const { __zigar, toUpper, Upper } = module;
+      const transform = createTransform(__zigar, toUpper, new Upper({}), {
+        chunkSize: 16,
+        highWaterMark: 1,
+      });
+      let written = 0;
+      const source = Readable.from((function*() {
+        for (let i = 0; i < 64; i++) {
+          yield Buffer.alloc(16, 'a');
+        }
+      })());
+      const slow = new Writable({
+        highWaterMark: 1,
+        write(chunk, encoding, cb) {
+          written += chunk.length;
+          setTimeout(cb, 1);
+        },
+      });
+      await pipeline(source, transform, slow);
+      expect(written).to.equal(64 * 16 + 1);
+    })
+  })
+  describe('createReadable', function() {
+    it('should pull data from Zig function', async function() {
+      const { __zigar, generate, Generator } = module;
+      const readable = createReadable(__zigar, generate, new Generator({ remaining: 10000 }), { chunkSize: 4096 });
+      const chunks = [];
+      await pipeline(readable, collect(chunks));
+      expect(chunks.map(c => c.length)).to.eql([ 4096, 4096, 1808 ]);
+    })
+  })
+  describe('createWritable', function() {
+    it('should coalesce chunks before passing them to Zig function', async function() {
+      const { __zigar, count, Counter } = module;
+      const state = new Counter({});
+      const writable = createWritable(__zigar, count, state, { chunkSize: 1024 });
+      const source = Readable.from((function*() {
+        for (let i = 0; i < 100; i++) {
+          yield Buffer.alloc(100, 'a');
+        }
+      })());
+      await pipeline(source, writable);
+      expect(state.total).to.equal(10000);
+      // 9 full chunks, 1 partial, then an empty one at the end
+      expect(state.calls).to.equal(11);
+    })
+  })
+})
+
+function collect(chunks) {
+  return new Writable({
+    write(chunk, encoding, cb) {
+      chunks.push(chunk);
+      cb();
+    },
+  });
+}
@@ -0,0 +1,46 @@
+const std = @import("std");
+
+pub const Upper = struct {
+    count: usize = 0,
+    pending: u8 = 0,
+};
+
+pub fn toUpper(state: *Upper, in: []const u8, out: []u8) !usize {
+    if (in.len == 0) {
+        // emit a terminating character at the end
+        if (state.pending != 0 and out.len > 0) {
+            out[0] = state.pending;
+            state.pending = 0;
+            return 1;
+        }
+        return 0;
+    }
+    for (in, out[0..in.len]) |c, *ptr| {
+        if (c == '!') return error.Exclamation;
+        ptr.* = std.ascii.toUpper(c);
+    }
+    state.count += in.len;
+    state.pending = '.';
+    return in.len;
+}
+
+pub const Counter = struct {
+    total: usize = 0,
+    calls: usize = 0,
+};
+
+pub fn count(state: *Counter, in: []const u8) void {
+    state.total += in.len;
+    state.calls += 1;
+}
+
+pub const Generator = struct {
+    remaining: usize,
+};
+
+pub fn generate(state: *Generator, out: []u8) usize {
+    const len = @min(out.len, state.remaining);
+    @memset(out[0..len], 'A');
+    state.remaining -= len;
+    return len;
+}
@@ -0,0 +1,48 @@
+import NodeResolve from '@rollup/plugin-node-resolve';
+import { createHash } from 'crypto';
+import { tmpdir } from 'os';
+import { join } from 'path';
+import { rollup } from 'rollup';
+import { fileURLToPath } from 'url';
+import { getBenchmarkOptions, runBenchmarks } from '../../zigar-compiler/test/integration/benchmark.js';
+import { getBenchmarks } from '../../zigar-compiler/test/integration/benchmarks-game/benchmarks.js';
+import Zigar from '../dist/index.js';
+
+const options = getBenchmarkOptions({ platform: 'rollup-plugin-zigar (wasm)' });
+await runBenchmarks('Zig Benchmarks Game', getBenchmarks(), importModule, options);
+
+async function importModule(url, { optimize }) {
+  const path = fileURLToPath(url);
+  const hash = md5(path);
+  const jsPath = join(tmpdir(), 'rollup-benchmark', optimize, `${hash}.mjs`);
+  const inputOptions = {
+    input: path,
+    plugins: [
+      Zigar({ optimize, useReadFile: true }),
+      NodeResolve({
+        modulePaths: [ resolve(`../node_modules`) ],
+      }),
+    ],
+  };
+  const outputOptions = {
+    file: jsPath,
+    format: 'esm',
+  };
+  const bundle = await rollup(inputOptions);
+  try {
+    await bundle.write(outputOptions);
+  } finally {
+    await bundle.close();
+  }
+  return import(jsPath);
+}
+
+function md5(text) {
+  const hash = createHash('md5');
+  hash.update(text);
+  return hash.digest('hex');
+}
+
+function resolve(relPath) {
+  return new URL(relPath, import.meta.url).pathname;
+}
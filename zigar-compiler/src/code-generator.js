@@ -9,11 +9,13 @@ export function generateCode(definition, params) {
     binarySource = null,
     topLevelAwait = true,
     omitExports = false,
+    omitTypeExports = false,
     declareFeatures = false,
     envOptions,
+    loadOptions,
   } = params;
   const features = (declareFeatures) ? getFeaturesUsed(structures) : [];
-  const exports = getExports(structures);
+  const exports = getExports(structures, omitTypeExports);
   const lines = [];
   const add = manageIndentation(lines);
   add(`import {`);
@@ -38,7 +40,7 @@ export function generateCode(definition, params) {
   if (binarySource) {
     add(`\n// initiate loading and compilation of WASM bytecodes`);
     add(`const source = ${binarySource};`);
-    add(`env.loadModule(source)`);
+    add(`env.loadModule(source${loadOptions ? `, ${JSON.stringify(loadOptions)}` : ''})`);
     // if top level await is used, we don't need to write changes into fixed memory buffers
     add(`env.linkVariables(${!topLevelAwait});`);
   }
@@ -316,13 +318,13 @@ function addStructureDefinitions(lines, definition) {
   add(`const root = ${structureNames.get(root)};`);
   add(`const options = {`)
   for (const [ name, value ] of Object.entries(options)) {
-    add(`${name}: ${value},`);
+    add(`${name}: ${JSON.stringify(value)},`);
   }
   add(`};`)
   return lines;
 }
 
-function getExports(structures) {
+function getExports(structures, omitTypes) {
   const root = structures[structures.length - 1];
   const { constructor } = root;
   const exportables = [];
@@ -334,6 +336,11 @@ function getExports(structures) {
     }
   }
   for (const member of root.static.members) {
+    // named exports are read when the module loads, defining the classes of all exported types;
+    // types can be left out so they're defined only when accessed through the default export
+    if (omitTypes && member.type === MemberType.Type) {
+      continue;
+    }
     // only read-only properties are exportable
     if (isReadOnly(member) && legal.test(member.name)) {
       try {
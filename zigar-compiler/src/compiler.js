@@ -1,13 +1,13 @@
 import ChildProcess from 'child_process';
 import { writeFileSync } from 'fs';
-import { readFile, readdir, stat, writeFile } from 'fs/promises';
+import { readFile, readdir, realpath, stat, writeFile } from 'fs/promises';
 import os from 'os';
-import { basename, isAbsolute, join, parse, resolve } from 'path';
+import { basename, dirname, extname, isAbsolute, join, parse, resolve, sep } from 'path';
 import { fileURLToPath } from 'url';
 import { promisify } from 'util';
 import {
-  acquireLock, copyFile, createDirectory, deleteDirectory, getArch, getDirectoryStats, getPlatform,
-  md5, releaseLock,
+  acquireLock, copyFile, createDirectory, deleteDirectory, findExecutable, getArch, getDirectoryStats,
+  getPlatform, hashFiles, linkFile, loadFile, md5, releaseLock,
 } from './utility-functions.js';
 
 const execFile = promisify(ChildProcess.execFile);
@@ -40,6 +40,12 @@ export async function compile(srcPath, modPath, options) {
     // only one process can compile a given file at a time
     const pidPath = `${moduleBuildDir}.pid`;
     await acquireLock(pidPath);
+    // see if the same sources have been built before, in which case the compiler isn't needed
+    const cached = await restoreFromCache(config);
+    if (cached) {
+      await releaseLock(pidPath);
+      return { outputPath, ...cached };
+    }
     const getOutputMTime = async () => {
       try {
         const stats = await stat(outputPath);
@@ -48,12 +54,14 @@ export async function compile(srcPath, modPath, options) {
       }
     };
     const outputMTimeBefore = await getOutputMTime();
+    let built = false;
     try {
       const { onStart, onEnd } = options;
       // create config file
       await createProject(config, moduleBuildDir);
       // then run the compiler
       await runCompiler(zigPath, zigArgs, { cwd: moduleBuildDir, onStart, onEnd });
+      built = true;
       // get list of files involved in build
       sourcePaths = await findSourcePaths(moduleBuildDir);
     } catch(err) {
@@ -77,10 +85,217 @@ export async function compile(srcPath, modPath, options) {
     if (config.packageConfigPath) {
       sourcePaths.push(config.packageConfigPath);
     }
+    if (built) {
+      await saveToCache(config, sourcePaths);
+    }
   }
   return { outputPath, changed, sourcePaths }
 }
 
+export async function compileMany(modules, options) {
+  // build all modules with one zig build, so that the build runner is only compiled once and
+  // the libraries are built in parallel using a common cache
+  const results = [];
+  const configs = [];
+  const separate = [];
+  for (const [ index, { srcPath, modPath } ] of modules.entries()) {
+    const srcInfo = (srcPath) ? await stat(srcPath) : null;
+    const path = (srcInfo?.isDirectory()) ? join(srcPath, '?') : srcPath;
+    const config = createConfig(path, modPath, options);
+    if (!srcPath) {
+      results[index] = { outputPath: config.outputPath, changed: false, sourcePaths: [] };
+      continue;
+    }
+    // modules with custom build file have to be built on their own
+    try {
+      await stat(join(config.moduleDir, 'build.zig'));
+      separate.push(index);
+      continue;
+    } catch (err) {
+    }
+    const cached = await restoreFromCache(config);
+    if (cached) {
+      results[index] = { outputPath: config.outputPath, ...cached };
+      continue;
+    }
+    configs.push({ index, config });
+  }
+  if (configs.length > 0) {
+    const [ { config: first } ] = configs;
+    const { zigPath, zigArgs, buildDir, clean } = first;
+    const names = configs.map(({ config }) => config.moduleBuildDir).sort();
+    const projectBuildDir = join(buildDir, 'multi-' + md5(names.join('\n')).slice(0, 8));
+    // acquire locks of individual modules as well, in a consistent order, as compile() might be
+    // building one of them at the same time
+    const pidPaths = [ ...names.map(n => `${n}.pid`), `${projectBuildDir}.pid` ];
+    for (const pidPath of pidPaths) {
+      await acquireLock(pidPath);
+    }
+    const getOutputMTime = async (outputPath) => {
+      try {
+        const stats = await stat(outputPath);
+        return stats.mtimeMs;
+      } catch (err) {
+      }
+    };
+    const mtimesBefore = [];
+    for (const { config } of configs) {
+      mtimesBefore.push(await getOutputMTime(config.outputPath));
+    }
+    let sourcePaths = [];
+    let built = false;
+    try {
+      const { onStart, onEnd } = options;
+      await createMultiProject(configs.map(c => c.config), projectBuildDir);
+      await runCompiler(zigPath, zigArgs, { cwd: projectBuildDir, onStart, onEnd });
+      built = true;
+      sourcePaths = await findSourcePaths(projectBuildDir);
+    } catch (err) {
+      if (err.code === 'ENOENT') {
+        const missing = configs.findIndex((c, i) => !mtimesBefore[i]);
+        if (missing !== -1) {
+          throw new MissingModule(configs[missing].config.outputPath);
+        }
+      } else {
+        throw err;
+      }
+    } finally {
+      if (clean) {
+        await deleteDirectory(projectBuildDir);
+      }
+      for (const pidPath of pidPaths.reverse()) {
+        await releaseLock(pidPath);
+      }
+      cleanBuildDirectory(first).catch(() => {});
+    }
+    for (const [ i, { index, config } ] of configs.entries()) {
+      const { outputPath } = config;
+      const changed = mtimesBefore[i] !== await getOutputMTime(outputPath);
+      // the cache is shared so the files involved can't be attributed to individual modules, and
+      // a module can import files from the folder of another; every module gets the whole list
+      const paths = [ ...sourcePaths, absolute('../zig/build-multi.zig') ];
+      if (built) {
+        await saveToCache(config, paths);
+      }
+      results[index] = { outputPath, changed, sourcePaths: paths };
+    }
+  }
+  for (const index of separate) {
+    const { srcPath, modPath } = modules[index];
+    results[index] = await compile(srcPath, modPath, options);
+  }
+  return results;
+}
+
+// Outputs are kept in the cache directory under a hash of the files involved in the build, the
+// Zig version and the build options. A manifest keyed on the latter two records which files were
+// involved the last time the module was built, so that freshness is determined by their content
+// rather than their mtimes, which fresh checkouts and container builds do not preserve.
+async function getBuildKey(config) {
+  const {
+    zigPath, cachePath, moduleName, modulePath, optimize, platform, arch, useLibc, isWASM, zigArgs,
+  } = config;
+  const zig = await getZigInstallation(zigPath, cachePath);
+  if (!zig) {
+    return;
+  }
+  const key = JSON.stringify({
+    zigVersion: zig.version, moduleName, modulePath, optimize, platform, arch, useLibc, isWASM, zigArgs,
+  });
+  return { key, zig };
+}
+
+async function getZigInstallation(zigPath, cachePath) {
+  // running the compiler to get its version would defeat the purpose, so the version is
+  // remembered along with the size and mtime of the executable
+  const exe = await findExecutable(zigPath);
+  if (!exe) {
+    return;
+  }
+  const listPath = join(cachePath, 'zig-versions.json');
+  let list;
+  try {
+    list = JSON.parse(await loadFile(listPath, '{}'));
+  } catch (err) {
+    list = {};
+  }
+  let entry = list[exe.path];
+  if (entry?.size !== exe.size || entry?.mtimeMs !== exe.mtimeMs) {
+    try {
+      const { stdout } = await execFile(exe.path, [ 'version' ], { windowsHide: true });
+      // std is part of the installation, covered by the version
+      const libDir = join(dirname(await realpath(exe.path)), 'lib');
+      entry = list[exe.path] = { size: exe.size, mtimeMs: exe.mtimeMs, version: stdout.trim(), libDir };
+      await createDirectory(cachePath);
+      await writeFile(listPath, JSON.stringify(list, undefined, 2));
+    } catch (err) {
+      return;
+    }
+  }
+  return entry;
+}
+
+function getCacheEntryPaths(config, key, hash) {
+  const { cachePath, outputPath } = config;
+  const manifestPath = join(cachePath, 'manifests', `${md5(key)}.json`);
+  const objectPath = (hash) ? join(cachePath, 'objects', `${hash}${extname(outputPath)}`) : undefined;
+  return { manifestPath, objectPath };
+}
+
+async function restoreFromCache(config) {
+  const { outputPath } = config;
+  try {
+    const build = await getBuildKey(config);
+    if (!build) {
+      return;
+    }
+    const { key, zig } = build;
+    const { manifestPath } = getCacheEntryPaths(config, key);
+    const { sourcePaths } = JSON.parse(await readFile(manifestPath, 'utf8'));
+    const hashedPaths = sourcePaths.filter(p => !p.startsWith(zig.libDir + sep));
+    const hash = await hashFiles(hashedPaths, key);
+    const { objectPath } = getCacheEntryPaths(config, key, hash);
+    const objectInfo = await stat(objectPath);
+    let changed = true;
+    try {
+      const outputInfo = await stat(outputPath);
+      if (outputInfo.ino === objectInfo.ino && outputInfo.dev === objectInfo.dev) {
+        changed = false;
+      } else if (outputInfo.size === objectInfo.size) {
+        // file was copied instead of linked
+        const [ a, b ] = await Promise.all([ readFile(outputPath), readFile(objectPath) ]);
+        changed = !a.equals(b);
+      }
+    } catch (err) {
+    }
+    if (changed) {
+      await linkFile(objectPath, outputPath);
+    }
+    return { changed, sourcePaths };
+  } catch (err) {
+  }
+}
+
+async function saveToCache(config, sourcePaths) {
+  const { outputPath } = config;
+  try {
+    const build = await getBuildKey(config);
+    if (!build) {
+      return;
+    }
+    const { key, zig } = build;
+    const hashedPaths = sourcePaths.filter(p => !p.startsWith(zig.libDir + sep));
+    const hash = await hashFiles(hashedPaths, key);
+    const { manifestPath, objectPath } = getCacheEntryPaths(config, key, hash);
+    // the compiler replaces the output file instead of writing into it, so the link won't
+    // end up pointing to a newer build
+    await linkFile(outputPath, objectPath);
+    await createDirectory(dirname(manifestPath));
+    await writeFile(manifestPath, JSON.stringify({ sourcePaths }));
+  } catch (err) {
+  }
+}
+
 export async function runCompiler(path, args, options) {
   const {
     cwd,
@@ -137,6 +352,20 @@ export function formatProjectConfig(config) {
   return lines.join('\n');
 }
 
+export function formatMultiProjectConfig(configs) {
+  const lines = [ 'pub const modules = .{' ];
+  for (const config of configs) {
+    lines.push('    .{');
+    for (const line of formatProjectConfig(config).split('\n')) {
+      const m = /^pub const (\w+) = (.*);$/.exec(line);
+      lines.push(`        .${m[1]} = ${m[2]},`);
+    }
+    lines.push('    },');
+  }
+  lines.push('};');
+  return lines.join('\n');
+}
+
 const wasmMainFn = `int main(void) { return 0; }`;
 
 export async function createProject(config, dir) {
@@ -152,6 +381,15 @@ export async function createProject(config, dir) {
   }
 }
 
+export async function createMultiProject(configs, dir) {
+  await createDirectory(dir);
+  const content = formatMultiProjectConfig(configs);
+  const cfgFilePath = join(dir, 'build-cfg.zig');
+  await writeFile(cfgFilePath, content);
+  const buildFilePath = join(dir, 'build.zig');
+  await copyFile(absolute('../zig/build-multi.zig'), buildFilePath);
+}
+
 const cwd = process.cwd();
 
 export function getCachePath(options) {
@@ -251,6 +489,7 @@ export function createConfig(srcPath, modPath, options = {}) {
     modulePath,
     moduleDir,
     moduleBuildDir,
+    cachePath: getCachePath(options),
     stubPath,
     buildDir,
     buildDirSize,
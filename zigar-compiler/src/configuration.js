@@ -16,10 +16,30 @@ export const optionsForCompile = {
     type: 'boolean',
     title: 'Omit all variables',
   },
+  omitArrayProxy: {
+    type: 'boolean',
+    title: 'Access array and slice elements through get() and set() only',
+  },
+  omitPointerProxy: {
+    type: 'boolean',
+    title: 'Access pointer targets through \'*\' and deref() only',
+  },
+  int64AsNumber: {
+    type: 'boolean',
+    title: 'Represent 64-bit integers as numbers instead of bigints',
+  },
+  int64AsNumberTypes: {
+    type: 'object',
+    title: 'List of 64-bit integer types to be represented as numbers',
+  },
   omitExports: {
     type: 'boolean',
     title: 'Omit export statements',
   },
+  omitTypeExports: {
+    type: 'boolean',
+    title: 'Export types through the default export only, so they\'re defined when first used',
+  },
   useLibc: {
     type: 'boolean',
     title: 'Link in C standard library',
@@ -56,6 +76,19 @@ export const optionsForCompile = {
     type: 'object',
     title: 'List of cross-compilation targets',
   },
+  lazyBinding: {
+    type: 'boolean',
+    title: 'Resolve symbols of shared library when they are first used instead of at load time',
+  },
+  ioRedirect: {
+    type: 'string',
+    enum: [ 'immediate', 'deferred', 'background' ],
+    title: 'When to redirect console output of shared library: at load time, before the first call, or in a separate thread',
+  },
+  profileStartup: {
+    type: 'boolean',
+    title: 'Record time spent in each phase of module loading',
+  },
 };
 
 export const optionsForTranspile = {
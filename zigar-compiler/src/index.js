@@ -1,5 +1,5 @@
 export { generateCode } from './code-generator.js';
-export { compile, getCachePath, getModuleCachePath } from './compiler.js';
+export { compile, compileMany, getCachePath, getModuleCachePath } from './compiler.js';
 export {
   extractOptions, findConfigFile, findSourceFile, loadConfigFile, optionsForCompile,
   optionsForTranspile
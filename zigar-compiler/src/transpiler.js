@@ -11,6 +11,7 @@ export async function transpile(path, options) {
     embedWASM = true,
     topLevelAwait = true,
     omitExports = false,
+    omitTypeExports = false,
     stripWASM = (options.optimize && options.optimize !== 'Debug'),
     keepNames = false,
     moduleResolver = (name) => name,
@@ -53,6 +54,7 @@ export async function transpile(path, options) {
     binarySource,
     topLevelAwait,
     omitExports,
+    omitTypeExports,
   });
   return { code, exports, structures, sourcePaths };
 }
@@ -1,10 +1,10 @@
 import childProcess, { execFileSync } from 'child_process';
 import { createHash } from 'crypto';
 import {
-  chmod, lstat, mkdir, open, readFile, readdir, rmdir, stat, unlink, writeFile
+  chmod, link, lstat, mkdir, open, readFile, readdir, rename, rmdir, stat, unlink, writeFile
 } from 'fs/promises';
 import os from 'os';
-import { dirname, join, sep } from 'path';
+import { delimiter, dirname, join, sep } from 'path';
 import { fileURLToPath } from 'url';
 import { promisify } from 'util';
 
@@ -75,6 +75,48 @@ export async function copyFile(srcPath, dstPath) {
   await chmod(dstPath, info.mode);
 }
 
+export async function linkFile(srcPath, dstPath) {
+  // put the file in place under a temporary name first so the destination is never missing
+  // or incomplete
+  const tmpPath = `${dstPath}.${process.pid}.tmp`;
+  await createDirectory(dirname(dstPath));
+  try {
+    await link(srcPath, tmpPath);
+  } catch (err) {
+    // different file system or no support for hard links
+    await copyFile(srcPath, tmpPath);
+  }
+  await rename(tmpPath, dstPath);
+}
+
+export async function hashFiles(paths, text = '') {
+  const hash = createHash('md5');
+  hash.update(text);
+  for (const path of paths) {
+    // include the path so that moving content between files yields a different hash
+    hash.update(`\n${path}\n`);
+    hash.update(await readFile(path));
+  }
+  return hash.digest('hex');
+}
+
+export async function findExecutable(name) {
+  const names = (os.platform() === 'win32' && !/\.exe$/i.test(name)) ? [ `${name}.exe`, name ] : [ name ];
+  const dirs = (name.includes('/') || name.includes(sep)) ? [ '' ] : (process.env.PATH ?? '').split(delimiter);
+  for (const dir of dirs) {
+    for (const n of names) {
+      const path = join(dir, n);
+      try {
+        const info = await stat(path);
+        if (info.isFile()) {
+          return { path, size: info.size, mtimeMs: info.mtimeMs };
+        }
+      } catch (err) {
+      }
+    }
+  }
+}
+
 export async function loadFile(path, def) {
   try {
     return await readFile(path, 'utf8');
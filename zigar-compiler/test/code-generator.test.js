@@ -738,6 +738,48 @@ describe('Code generation', function() {
       expect(code).to.not.contain('export {');
       expect(exports).to.contain('__zigar');
     })
+    it('should leave types out of named exports when omitTypeExports is true', function() {
+      const structure = {
+        constructor: { Hello: function() {}, count: 5, hello: function() {} },
+        type: StructureType.Struct,
+        name: "package",
+        byteSize: 0,
+        hasPointer: false,
+        instance: {
+          members: [],
+          methods: [],
+          template: null,
+        },
+        static: {
+          members: [
+            {
+              type: MemberType.Type,
+              name: 'Hello',
+              structure: {},
+            },
+            {
+              type: MemberType.Comptime,
+              name: 'count',
+              structure: {},
+            },
+          ],
+          methods: [
+            {
+              name: 'hello',
+              argStruct: {},
+              thunkId: 1,
+            },
+          ],
+          template: null,
+        },
+      };
+      const def = { structures: [ structure ], options, keys: { MEMORY, SLOTS }};
+      const { exports: allExports } = generateCode(def, params);
+      expect(allExports).to.eql([ 'default', '__zigar', 'hello', 'Hello', 'count' ]);
+      const { code, exports } = generateCode(def, { omitTypeExports: true, ...params });
+      expect(exports).to.eql([ 'default', '__zigar', 'hello', 'count' ]);
+      expect(code).to.not.contain('as Hello');
+    })
     it('should break initializer into multiple lines when the number of structures is large', function() {
       const structures = [];
       for (let bitSize = 2; bitSize <= 64; bitSize++) {
@@ -802,5 +844,38 @@ describe('Code generation', function() {
       expect(code).to.contain('addonPath');
       expect(code).to.contain('/tmp/somewhere');
     })
+    it('should pass options to loadModule', function() {
+      const structure = {
+        constructor: null,
+        type: StructureType.Primitive,
+        name: "f32",
+        byteSize: 4,
+        isConst: false,
+        hasPointer: false,
+        instance: {
+          members: [
+            {
+              type: MemberType.Float,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+            }
+          ],
+          methods: [],
+          template: null,
+        },
+        static: {
+          members: [],
+          methods: [],
+          template: null,
+        },
+      };
+      const loadOptions = { lazyBinding: true, ioRedirect: 'deferred', profile: false };
+      const def = { structures: [ structure ], options, keys: { MEMORY, SLOTS }};
+      const { code } = generateCode(def, { ...params, binarySource: '"/tmp/lib.so"', loadOptions });
+      expect(code).to.contain('env.loadModule(source, {"lazyBinding":true,"ioRedirect":"deferred","profile":false})');
+      const { code: codeAlt } = generateCode(def, { ...params, binarySource: '"/tmp/lib.so"' });
+      expect(codeAlt).to.contain('env.loadModule(source)');
+    })
   })
 })
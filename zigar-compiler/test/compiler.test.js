@@ -1,6 +1,6 @@
 import { expect, use } from 'chai';
 import { chaiPromised } from 'chai-promised';
-import { readdir, stat } from 'fs/promises';
+import { readdir, stat, utimes } from 'fs/promises';
 import os, { tmpdir } from 'os';
 import { join, sep } from 'path';
 import { fileURLToPath } from 'url';
@@ -9,7 +9,9 @@ use(chaiPromised);
 
 import {
   compile,
+  compileMany,
   createConfig,
+  formatMultiProjectConfig,
   getModuleCachePath,
   runCompiler
 } from '../src/compiler.js';
@@ -101,6 +103,21 @@ describe('Compilation', function() {
       expect(config.outputPath).to.equal(join(modPath, 'freebsd.arm64.so'));
     })
   })
+  describe('formatMultiProjectConfig', function() {
+    it('should place config of each module in a tuple', function() {
+      const options = { platform: 'linux', arch: 'x64' };
+      const configs = [
+        createConfig('/home/user/a/foo.zig', '/home/user/.zigar-cache/foo.zigar', options),
+        createConfig('/home/user/b/bar.zig', '/home/user/.zigar-cache/bar.zigar', options),
+      ];
+      const content = formatMultiProjectConfig(configs);
+      expect(content).to.match(/^pub const modules = \.\{/);
+      expect(content).to.contain('.module_name = "foo",');
+      expect(content).to.contain('.module_path = "/home/user/b/bar.zig",');
+      expect(content).to.contain(`.output_path = ${JSON.stringify(join('/home/user/.zigar-cache/bar.zigar', 'linux.x64.so'))},`);
+      expect(content.match(/\.is_wasm = false,/g)).to.have.lengthOf(2);
+    })
+  })
   describe('compile', function() {
     it('should compile zig source code for C addon', async function() {
       this.timeout(600000);
@@ -325,6 +342,56 @@ describe('Compilation', function() {
       expect(hasBuildFile).to.be.true;
       expect(hasPackageCfgFile).to.be.true;
     })
+    it('should not run compiler when content of source files has not changed', async function() {
+      this.timeout(600000);
+      const srcPath = absolute('./zig-samples/basic/integers.zig');
+      const options = { optimize: 'Debug', platform: os.platform(), arch: os.arch() };
+      const modPath = getModuleCachePath(srcPath, options);
+      await compile(srcPath, modPath, options);
+      // simulate a fresh checkout
+      const time = new Date();
+      await utimes(srcPath, time, time);
+      let started = false;
+      const { changed, sourcePaths } = await compile(srcPath, modPath, {
+        ...options,
+        onStart: () => started = true,
+      });
+      expect(started).to.be.false;
+      expect(changed).to.be.false;
+      expect(sourcePaths.find(p => p.includes('integers.zig'))).to.be.a('string');
+    })
+    it('should compile multiple modules in one go', async function() {
+      this.timeout(600000);
+      const options = { optimize: 'Debug', platform: os.platform(), arch: os.arch() };
+      const modules = [ 'integers', 'simple' ].map((name) => {
+        const srcPath = absolute(`./zig-samples/basic/${name}.zig`);
+        const modPath = getModuleCachePath(srcPath, options);
+        return { srcPath, modPath };
+      });
+      const results = await compileMany(modules, options);
+      expect(results).to.have.lengthOf(2);
+      for (const { outputPath, sourcePaths } of results) {
+        const { size } = await stat(outputPath);
+        expect(size).to.be.at.least(1000);
+        expect(sourcePaths).to.not.be.empty;
+      }
+      // files can't be attributed to individual modules, so every module depends on all of them
+      expect(results[0].sourcePaths).to.eql(results[1].sourcePaths);
+      // nothing should change the second time around
+      const resultsAfter = await compileMany(modules, options);
+      expect(resultsAfter.map(r => r.changed)).to.eql([ false, false ]);
+    })
+    it('should compile module with custom build file on its own', async function() {
+      this.timeout(600000);
+      const options = { optimize: 'Debug', platform: os.platform(), arch: os.arch() };
+      const modules = [ './zig-samples/custom/custom.zig', './zig-samples/basic/integers.zig' ].map((path) => {
+        const srcPath = absolute(path);
+        const modPath = getModuleCachePath(srcPath, options);
+        return { srcPath, modPath };
+      });
+      const [ custom ] = await compileMany(modules, options);
+      expect(custom.sourcePaths.find(p => p.includes('build.zig.zon'))).to.be.a('string');
+    })
     it('should begin deleting files from build directory when it becomes too large', async function() {
       this.timeout(600000);
       const srcPath = absolute('./zig-samples/basic/integers.zig');
@@ -0,0 +1,141 @@
+import { readFile, writeFile } from 'fs/promises';
+import { performance } from 'perf_hooks';
+import { parseArgs } from 'util';
+
+export function getBenchmarkOptions(defaults = {}) {
+  const { values } = parseArgs({
+    options: {
+      optimize: { type: 'string', default: 'ReleaseFast' },
+      output: { type: 'string' },
+      baseline: { type: 'string' },
+      threshold: { type: 'string', default: '0.1' },
+      repeat: { type: 'string', default: '5' },
+      filter: { type: 'string' },
+      quick: { type: 'boolean', default: false },
+    },
+    strict: false,
+  });
+  return {
+    ...defaults,
+    ...values,
+    threshold: parseFloat(values.threshold),
+    repeat: parseInt(values.repeat),
+  };
+}
+
+export async function runBenchmarks(title, cases, importModule, options) {
+  const {
+    platform,
+    optimize,
+    output,
+    baseline,
+    threshold = 0.1,
+    repeat = 5,
+    filter,
+    quick = false,
+  } = options;
+  console.log(`\n${title} (${platform}, ${optimize})`);
+  console.log('-'.repeat(title.length + platform.length + optimize.length + 5));
+  const results = [];
+  for (const { name, url, sizes, setup, run, unit = 'op' } of cases) {
+    if (filter && !name.includes(filter)) {
+      continue;
+    }
+    const module = await importModule(url, options);
+    // use only the smallest size when a quick check is desired
+    for (const size of (quick) ? sizes.slice(0, 1) : sizes) {
+      const input = await setup?.(size, module);
+      // count calls into Zig during an untimed warm-up run
+      module.__zigar.stats?.({ collect: true });
+      const count = await run(module, size, input);
+      const stats = module.__zigar.stats?.({ collect: false }) ?? [];
+      const ffiCalls = stats.reduce((t, r) => t + r.calls, 0);
+      const allocations = stats.reduce((t, r) => t + r.allocations, 0);
+      // heap growth during a single run, only meaningful when gc() is available
+      let heapPerUnit = null;
+      if (globalThis.gc) {
+        globalThis.gc();
+        const heapBefore = process.memoryUsage().heapUsed;
+        await run(module, size, input);
+        heapPerUnit = Math.max(0, process.memoryUsage().heapUsed - heapBefore) / count;
+      }
+      const times = [];
+      let peakRSS = 0;
+      globalThis.gc?.();
+      const startRSS = process.memoryUsage().rss;
+      for (let i = 0; i < repeat; i++) {
+        const start = performance.now();
+        await run(module, size, input);
+        times.push(performance.now() - start);
+        peakRSS = Math.max(peakRSS, process.memoryUsage().rss - startRSS);
+      }
+      times.sort((a, b) => a - b);
+      const wallTime = times[times.length >> 1];
+      const throughput = count / (wallTime / 1000);
+      const timePerUnit = wallTime * 1e6 / count;
+      const result = {
+        name, size, wallTime, minTime: times[0], throughput, unit, timePerUnit, heapPerUnit,
+        rss: peakRSS, ffiCalls, allocations,
+      };
+      results.push(result);
+      console.log([
+        `${name} (${size})`.padEnd(36),
+        `${wallTime.toFixed(2).padStart(10)} ms`,
+        `${formatNumber(throughput).padStart(14)} ${unit}/s`,
+        `${formatNumber(timePerUnit).padStart(10)} ns/${unit}`,
+        `${(heapPerUnit !== null) ? formatNumber(heapPerUnit).padStart(8) : '-'.padStart(8)} B/${unit}`,
+        `${(peakRSS / 1024 / 1024).toFixed(1).padStart(8)} MB`,
+        `${formatNumber(ffiCalls).padStart(10)} calls`,
+      ].join('  '));
+    }
+    await module.__zigar.abandon();
+  }
+  const report = {
+    title,
+    platform,
+    optimize,
+    runtime: (typeof(Bun) === 'object') ? `bun ${Bun.version}` : `node ${process.version}`,
+    date: new Date().toISOString(),
+    results,
+  };
+  if (output) {
+    await writeFile(output, JSON.stringify(report, null, 2));
+  }
+  if (baseline) {
+    const reference = JSON.parse(await readFile(baseline, 'utf-8'));
+    const regressions = compareResults(report, reference, threshold);
+    if (regressions.length > 0) {
+      process.exitCode = 1;
+    }
+  }
+  return report;
+}
+
+export function compareResults(report, reference, threshold) {
+  console.log(`\nComparison against baseline from ${reference.date} (${reference.runtime})`);
+  const regressions = [];
+  for (const result of report.results) {
+    const before = reference.results.find(r => r.name === result.name && r.size === result.size);
+    if (!before) {
+      continue;
+    }
+    const ratio = result.wallTime / before.wallTime;
+    const regressed = ratio > 1 + threshold;
+    if (regressed) {
+      regressions.push({ ...result, ratio });
+    }
+    const change = ((ratio - 1) * 100).toFixed(1);
+    console.log([
+      `${result.name} (${result.size})`.padEnd(36),
+      `${before.wallTime.toFixed(2).padStart(10)} ms ->`,
+      `${result.wallTime.toFixed(2).padStart(10)} ms`,
+      `${(ratio >= 1 ? '+' : '') + change}%`.padStart(8),
+      (regressed) ? 'REGRESSION' : '',
+    ].join('  '));
+  }
+  return regressions;
+}
+
+function formatNumber(n) {
+  return Math.round(n).toLocaleString('en-US');
+}
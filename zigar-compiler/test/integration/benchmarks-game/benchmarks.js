@@ -0,0 +1,167 @@
+import { readFile } from 'fs/promises';
+import { fileURLToPath } from 'url';
+import { capture } from '../capture.js';
+
+export function getBenchmarks() {
+  const moduleURL = (name) => new URL(`./${name}.zig`, import.meta.url).href;
+  const loadData = async (name, encoding) => {
+    const url = new URL(`./data/${name}.txt`, import.meta.url).href;
+    const data = await readFile(fileURLToPath(url), encoding);
+    return (typeof(data) === 'string') ? data.trim().split(/\r?\n/) : data;
+  };
+  return [
+    {
+      name: 'binary-trees',
+      url: moduleURL('binary-trees'),
+      sizes: [ 10, 12, 14 ],
+      unit: 'run',
+      run: async ({ binaryTree }, n) => {
+        await capture(() => binaryTree(n));
+        return 1;
+      },
+    },
+    {
+      name: 'fannkuch-redux',
+      url: moduleURL('fannkuch-redux'),
+      sizes: [ 8, 9, 10 ],
+      unit: 'perm',
+      run: ({ Pfannkuchen }, n) => {
+        Pfannkuchen(n);
+        return factorial(n);
+      },
+    },
+    {
+      name: 'fasta',
+      url: moduleURL('fasta'),
+      sizes: [ 25000, 250000, 2500000 ],
+      unit: 'char',
+      run: async ({ fasta }, n) => {
+        await capture(() => fasta(n));
+        // ALU, IUB and Homo sapiens sequences are 2n, 3n and 5n long
+        return n * 10;
+      },
+    },
+    {
+      name: 'k-nucleotide',
+      url: moduleURL('k-nucleotide'),
+      sizes: [ 250000 ],
+      unit: 'line',
+      setup: async (n) => {
+        const lines = await loadData(`fasta-${n}`, 'utf-8');
+        const start = lines.findIndex(l => l.startsWith('>THREE'));
+        return lines.slice(start + 1);
+      },
+      run: ({ kNucleotide }, n, input) => {
+        kNucleotide(input);
+        return input.length;
+      },
+    },
+    {
+      name: 'mandelbrot',
+      url: moduleURL('mandelbrot'),
+      sizes: [ 500, 1000, 2000 ],
+      unit: 'pixel',
+      run: async ({ mandelbrot }, n) => {
+        await capture(() => mandelbrot(n));
+        return n * n;
+      },
+    },
+    {
+      name: 'nbody',
+      url: moduleURL('nbody'),
+      sizes: [ 50000, 500000, 5000000 ],
+      unit: 'step',
+      run: ({ Planets, solar_mass, year, advance, offset_momentum }, n) => {
+        const solar_bodies = new Planets(createSolarBodies(solar_mass, year));
+        offset_momentum(solar_bodies);
+        advance(solar_bodies, 0.01, n);
+        return n;
+      },
+    },
+    {
+      name: 'reverse-complement',
+      url: moduleURL('reverse-complement'),
+      sizes: [ 250000 ],
+      unit: 'byte',
+      setup: (n) => loadData(`fasta-${n}`),
+      run: ({ reverseComplement }, n, data) => {
+        // data is modified in place, running it again simply reverses it back
+        reverseComplement(data);
+        return data.byteLength;
+      },
+    },
+    {
+      name: 'spectral-norm',
+      url: moduleURL('spectral-norm'),
+      sizes: [ 100, 500, 1500 ],
+      unit: 'elem',
+      run: ({ spectralNorm }, n) => {
+        spectralNorm(n);
+        return n * n;
+      },
+    },
+  ];
+}
+
+function createSolarBodies(solar_mass, year) {
+  return [
+    // Sun
+    {
+      x: 0.0,
+      y: 0.0,
+      z: 0.0,
+      vx: 0.0,
+      vy: 0.0,
+      vz: 0.0,
+      mass: solar_mass,
+    },
+    // Jupiter
+    {
+      x: 4.84143144246472090e+00,
+      y: -1.16032004402742839e+00,
+      z: -1.03622044471123109e-01,
+      vx: 1.66007664274403694e-03 * year,
+      vy: 7.69901118419740425e-03 * year,
+      vz: -6.90460016972063023e-05 * year,
+      mass: 9.54791938424326609e-04 * solar_mass,
+    },
+    // Saturn
+    {
+      x: 8.34336671824457987e+00,
+      y: 4.12479856412430479e+00,
+      z: -4.03523417114321381e-01,
+      vx: -2.76742510726862411e-03 * year,
+      vy: 4.99852801234917238e-03 * year,
+      vz: 2.30417297573763929e-05 * year,
+      mass: 2.85885980666130812e-04 * solar_mass,
+    },
+    // Uranus
+    {
+      x: 1.28943695621391310e+01,
+      y: -1.51111514016986312e+01,
+      z: -2.23307578892655734e-01,
+      vx: 2.96460137564761618e-03 * year,
+      vy: 2.37847173959480950e-03 * year,
+      vz: -2.96589568540237556e-05 * year,
+      mass: 4.36624404335156298e-05 * solar_mass,
+    },
+    // Neptune
+    {
+      x: 1.53796971148509165e+01,
+      y: -2.59193146099879641e+01,
+      z: 1.79258772950371181e-01,
+      vx: 2.68067772490389322e-03 * year,
+      vy: 1.62824170038242295e-03 * year,
+      vz: -9.51592254519715870e-05 * year,
+      mass: 5.15138902046611451e-05 * solar_mass,
+    },
+  ];
+}
+
+function factorial(n) {
+  let f = 1;
+  for (let i = 2; i <= n; i++) {
+    f *= i;
+  }
+  return f;
+}
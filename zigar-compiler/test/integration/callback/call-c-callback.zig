@@ -0,0 +1,15 @@
+pub const Callback = *const fn (i64, f32) callconv(.C) void;
+
+pub var stored: ?Callback = null;
+
+pub fn store(cb: ?Callback) void {
+    stored = cb;
+}
+
+pub fn invoke(a: i64, b: f32) bool {
+    if (stored) |cb| {
+        cb(a, b);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,6 @@
+pub fn count(n: i32, cb: *const fn (i32) void) void {
+    var i: i32 = 0;
+    while (i < n) : (i += 1) {
+        cb(i);
+    }
+}
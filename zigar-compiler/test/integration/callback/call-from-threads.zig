@@ -0,0 +1,22 @@
+const std = @import("std");
+
+pub const Callback = *const fn (u32, u32) void;
+
+pub fn spawn(thread_count: u32, call_count: u32, cb: Callback) !void {
+    for (0..thread_count) |index| {
+        const thread = try std.Thread.spawn(.{}, run, .{ @as(u32, @intCast(index)), call_count, cb });
+        thread.detach();
+    }
+}
+
+fn run(index: u32, call_count: u32, cb: Callback) void {
+    var prng = std.Random.DefaultPrng.init(index);
+    const random = prng.random();
+    for (0..call_count) |i| {
+        cb(index, @intCast(i));
+        if (random.uintLessThan(u8, 16) == 0) {
+            // let other threads get ahead
+            std.time.sleep(random.uintLessThan(u64, 50000));
+        }
+    }
+}
@@ -0,0 +1,13 @@
+pub const Progress = struct {
+    done: u32,
+    total: u32,
+    ratio: f64,
+};
+
+pub fn run(total: u32, cb: *const fn (Progress, bool) void) void {
+    var done: u32 = 0;
+    while (done < total) {
+        done += 1;
+        cb(.{ .done = done, .total = total, .ratio = @as(f64, @floatFromInt(done)) / @as(f64, @floatFromInt(total)) }, done == total);
+    }
+}
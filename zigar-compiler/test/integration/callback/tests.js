@@ -0,0 +1,95 @@
+import { expect } from 'chai';
+import 'mocha-skip-if';
+
+export function addTests(importModule, options) {
+  const { target } = options;
+  const importTest = async (name) => {
+      const url = new URL(`./${name}.zig`, import.meta.url).href;
+      return importModule(url);
+  };
+  const waitFor = async (cb, timeout = 60000) => {
+    const start = Date.now();
+    while (!cb()) {
+      if (Date.now() - start > timeout) {
+        throw new Error('Timeout');
+      }
+      await new Promise(r => setTimeout(r, 10));
+    }
+  };
+  // JavaScript cannot be called from other threads in WebAssembly
+  const nonWASM = target !== 'wasm32';
+  describe('Callback', function() {
+    skip.permanently.unless(nonWASM).
+    it('should call JS function asynchronously in the order of calls', async function() {
+      this.timeout(300000);
+      const { count, __zigar } = await importTest('call-from-same-thread');
+      const list = [];
+      const f = (i) => list.push(i);
+      count(5, f);
+      // calls are delivered only after the current JS code has finished
+      expect(list).to.eql([]);
+      await waitFor(() => list.length === 5);
+      expect(list).to.eql([ 0, 1, 2, 3, 4 ]);
+      count(3, f);
+      await waitFor(() => list.length === 8);
+      expect(list.slice(5)).to.eql([ 0, 1, 2 ]);
+      expect(__zigar.releaseCallback(f)).to.equal(1);
+    })
+    skip.permanently.unless(nonWASM).
+    it('should pass struct to JS function', async function() {
+      this.timeout(300000);
+      const { run, __zigar } = await importTest('call-with-struct');
+      const list = [];
+      const f = (progress, last) => list.push({ ...progress.valueOf(), last });
+      run(4, f);
+      await waitFor(() => list.length === 4);
+      expect(list[0]).to.eql({ done: 1, total: 4, ratio: 0.25, last: false });
+      expect(list[3]).to.eql({ done: 4, total: 4, ratio: 1, last: true });
+      __zigar.releaseCallback(f);
+    })
+    skip.permanently.unless(nonWASM).
+    it('should store callback with C calling convention in variable', async function() {
+      this.timeout(300000);
+      const module = await importTest('call-c-callback');
+      const { store, invoke, __zigar } = module;
+      const list = [];
+      const f = (a, b) => list.push([ a, b ]);
+      expect(invoke(1n, 1)).to.be.false;
+      store(f);
+      expect(module.stored).to.equal(f);
+      expect(invoke(1234n, 0.5)).to.be.true;
+      await waitFor(() => list.length === 1);
+      expect(list).to.eql([ [ 1234n, 0.5 ] ]);
+      __zigar.releaseCallback(f);
+      // calls made after the function is released are dropped
+      expect(invoke(5678n, 0.25)).to.be.true;
+      await new Promise(r => setTimeout(r, 50));
+      expect(list).to.have.lengthOf(1);
+      store(null);
+      expect(module.stored).to.be.null;
+    })
+    skip.permanently.unless(nonWASM).
+    it('should receive calls from many threads', async function() {
+      this.timeout(300000);
+      const { spawn, __zigar } = await importTest('call-from-threads');
+      const threadCount = 64;
+      const callCount = 2000;
+      const received = Array(threadCount).fill(0);
+      let total = 0;
+      let outOfOrder = 0;
+      const f = (index, i) => {
+        // calls from the same thread must arrive in order
+        if (received[index] !== i) {
+          outOfOrder++;
+        }
+        received[index] = i + 1;
+        total++;
+      };
+      spawn(threadCount, callCount, f);
+      await waitFor(() => total === threadCount * callCount);
+      expect(outOfOrder).to.equal(0);
+      expect(received).to.eql(Array(threadCount).fill(callCount));
+      __zigar.releaseCallback(f);
+    })
+  })
+}
@@ -0,0 +1,33 @@
+const Iterator = struct {
+    index: usize = 0,
+    count: usize,
+    fail_at: usize,
+
+    pub const zigar_prefetch = true;
+
+    pub fn next(self: *@This()) !?usize {
+        defer self.index += 1;
+        if (self.index == self.fail_at) return error.Unlucky;
+        if (self.index >= self.count) return null;
+        return self.index;
+    }
+};
+
+pub fn getIterator(count: usize, fail_at: usize) Iterator {
+    return .{ .count = count, .fail_at = fail_at };
+}
+
+const CountingIterator = struct {
+    index: usize = 0,
+    count: usize,
+
+    pub fn next(self: *@This()) ?usize {
+        defer self.index += 1;
+        if (self.index >= self.count) return null;
+        return self.index;
+    }
+};
+
+pub fn getCountingIterator(count: usize) CountingIterator {
+    return .{ .count = count };
+}
@@ -54,5 +54,66 @@ export function addTests(importModule, options) {
       }
       expect(list).to.eql([ 'home', 'chicken', 'porn', 'naked-chicks.png' ]);
     })
+    it('should handle iterator returning error union', async function() {
+      this.timeout(300000);
+      const { getIterator } = await importTest('error-iterator');
+      const list1 = [];
+      expect(() => {
+        for (const value of getIterator(100000, 50000)) {
+          list1.push(value);
+        }
+      }).to.throw(Error).with.property('message', 'Unlucky');
+      expect(list1).to.have.lengthOf(50000);
+      expect(list1[49999]).to.equal(49999);
+      const list2 = [];
+      for (const value of getIterator(100000, 200000)) {
+        list2.push(value);
+      }
+      expect(list2).to.have.lengthOf(100000);
+      const iterator = getIterator(10, 3)[Symbol.iterator]();
+      expect(iterator.next()).to.eql({ value: 0, done: false });
+      expect(iterator.next()).to.eql({ value: 1, done: false });
+      expect(iterator.next()).to.eql({ value: 2, done: false });
+      expect(() => iterator.next()).to.throw(Error).with.property('message', 'Unlucky');
+      expect(iterator.next()).to.eql({ value: 4, done: false });
+    })
+    it('should not lose items when loop exits early', async function() {
+      this.timeout(300000);
+      const { getCountingIterator } = await importTest('error-iterator');
+      const iterator = getCountingIterator(100);
+      const list = [];
+      for (const value of iterator) {
+        list.push(value);
+        if (value === 10) {
+          break;
+        }
+      }
+      expect(iterator.next()).to.equal(11);
+      for (const value of iterator) {
+        list.push(value);
+      }
+      expect(list).to.have.lengthOf(99);
+      expect(list[11]).to.equal(12);
+    })
+    it('should allow the use of for await with iterator', async function() {
+      this.timeout(300000);
+      const { getIterator } = await importTest('error-iterator');
+      const list1 = [];
+      for await (const value of getIterator(1000, 2000)) {
+        list1.push(value);
+      }
+      expect(list1).to.have.lengthOf(1000);
+      const list2 = [];
+      let error;
+      try {
+        for await (const value of getIterator(1000, 5)) {
+          list2.push(value);
+        }
+      } catch (err) {
+        error = err;
+      }
+      expect(list2).to.eql([ 0, 1, 2, 3, 4 ]);
+      expect(error).to.be.an('error').with.property('message', 'Unlucky');
+    })
   })
 }
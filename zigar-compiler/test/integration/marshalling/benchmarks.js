@@ -0,0 +1,132 @@
+import { arch, platform } from 'os';
+
+// number of calls made per run, fewer when each call moves a lot of data
+const callCount = (size) => Math.max(1000, Math.min(100000, Math.floor(1e7 / size)));
+
+const repeat = (count, cb) => {
+  for (let i = 0; i < count; i++) {
+    cb(i);
+  }
+  return count;
+};
+
+export function getBenchmarks() {
+  const moduleURL = (name) => new URL(`./${name}.zig`, import.meta.url).href;
+  const url = moduleURL('marshalling');
+  const scalar = (name, fn, arg) => ({
+    name,
+    url,
+    sizes: [ 1 ],
+    unit: 'call',
+    run: (module) => repeat(callCount(1), () => module[fn](arg)),
+  });
+  const cases = [
+    scalar('void', 'noArgs'),
+    scalar('bool', 'passBool', true),
+    scalar('i32', 'passI32', 1234),
+    scalar('u64', 'passU64', 1234n),
+    scalar('i128', 'passI128', -1234n),
+    scalar('f64', 'passF64', 3.14),
+    scalar('enum', 'passEnum', 'green'),
+    scalar('struct', 'passStruct', { x: 1, y: 2 }),
+    scalar('union', 'passUnion', { float: 3.14 }),
+    scalar('array [16]u32', 'passArray', new Uint32Array(16)),
+    scalar('optional (value)', 'passOptional', 1234),
+    scalar('optional (null)', 'passOptional', null),
+    scalar('error union', 'passErrorUnion', 1234),
+    scalar('pointer', 'passPointer', { x: 1, y: 2 }),
+    scalar('allocator', 'passAllocator'),
+    {
+      name: 'error union (error)',
+      url,
+      sizes: [ 1 ],
+      unit: 'call',
+      run: ({ passErrorUnion }) => repeat(callCount(1), () => {
+        try {
+          passErrorUnion(13);
+        } catch (err) {
+        }
+      }),
+    },
+    {
+      name: 'slice (typed array)',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      setup: (n) => new Uint32Array(n),
+      run: ({ passSlice }, n, array) => repeat(callCount(n), () => passSlice(array)),
+    },
+    {
+      name: 'slice (js array)',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      setup: (n) => new Array(n).fill(1),
+      run: ({ passSlice }, n, array) => repeat(callCount(n), () => passSlice(array)),
+    },
+    {
+      name: 'string',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      setup: (n) => 'a'.repeat(n),
+      run: ({ passString }, n, text) => repeat(callCount(n), () => passString(text)),
+    },
+    {
+      name: 'string list',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      setup: (n) => Array.from({ length: n }, (_, i) => `token${i}`),
+      run: ({ passStringList }, n, list) => repeat(callCount(n), () => passStringList(list)),
+    },
+    {
+      name: 'return slice',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      run: ({ returnSlice }, n) => repeat(callCount(n), () => returnSlice(n).typedArray),
+    },
+    {
+      name: 'return string',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      run: ({ returnString }, n) => repeat(callCount(n), () => returnString(n).string),
+    },
+    {
+      name: 'return string list',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      run: ({ returnStringList }, n) => repeat(callCount(n), () => {
+        for (const token of returnStringList(n)) {
+          token.string;
+        }
+      }),
+    },
+    {
+      name: 'return pointer list',
+      url,
+      sizes: [ 16, 1024, 65536 ],
+      unit: 'call',
+      run: ({ returnPointerList }, n) => repeat(callCount(n), () => {
+        for (const point of returnPointerList(n)) {
+          point.x;
+        }
+      }),
+    },
+  ];
+  // VaList is "disabled due to miscompilations" on 64-bits Windows and ARM64 Linux currently
+  if (!(platform() === 'win32' && arch() === 'x64') && !(platform() === 'linux' && arch() === 'arm64')) {
+    cases.push({
+      name: 'variadic',
+      url: moduleURL('call-variadic'),
+      sizes: [ 1, 4, 16 ],
+      unit: 'call',
+      setup: (n, { Int32 }) => Array.from({ length: n }, (_, i) => new Int32(i)),
+      run: ({ sumIntegers }, n, args) => repeat(callCount(n), () => sumIntegers(n, ...args)),
+    });
+  }
+  return cases;
+}
@@ -0,0 +1,9 @@
+pub const Int32 = i32;
+
+pub fn sumIntegers(count: usize, ...) callconv(.C) i32 {
+    var va_list = @cVaStart();
+    defer @cVaEnd(&va_list);
+    var sum: i32 = 0;
+    for (0..count) |_| sum +%= @cVaArg(&va_list, i32);
+    return sum;
+}
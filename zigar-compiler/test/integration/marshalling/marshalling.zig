@@ -0,0 +1,129 @@
+const std = @import("std");
+
+pub const Point = struct {
+    x: f64,
+    y: f64,
+};
+pub const Color = enum { red, green, blue };
+pub const Number = union(enum) {
+    integer: i32,
+    float: f64,
+};
+pub const Error = error{Unlucky};
+
+pub fn noArgs() void {}
+
+pub fn passBool(arg: bool) bool {
+    return arg;
+}
+
+pub fn passI32(arg: i32) i32 {
+    return arg;
+}
+
+pub fn passU64(arg: u64) u64 {
+    return arg;
+}
+
+pub fn passI128(arg: i128) i128 {
+    return arg;
+}
+
+pub fn passF64(arg: f64) f64 {
+    return arg;
+}
+
+pub fn passEnum(arg: Color) Color {
+    return arg;
+}
+
+pub fn passStruct(arg: Point) Point {
+    return arg;
+}
+
+pub fn passUnion(arg: Number) Number {
+    return arg;
+}
+
+pub fn passArray(arg: [16]u32) [16]u32 {
+    return arg;
+}
+
+pub fn passOptional(arg: ?i32) ?i32 {
+    return arg;
+}
+
+pub fn passErrorUnion(arg: i32) Error!i32 {
+    if (arg == 13) return error.Unlucky;
+    return arg;
+}
+
+pub fn passPointer(arg: *const Point) f64 {
+    return arg.x + arg.y;
+}
+
+pub fn passSlice(arg: []const u32) u32 {
+    var sum: u32 = 0;
+    for (arg) |value| sum +%= value;
+    return sum;
+}
+
+pub fn passString(arg: []const u8) usize {
+    return arg.len;
+}
+
+pub fn passStringList(arg: []const []const u8) usize {
+    var total: usize = 0;
+    for (arg) |string| total += string.len;
+    return total;
+}
+
+pub fn passAllocator(allocator: std.mem.Allocator) !void {
+    const ptr = try allocator.create(u32);
+    allocator.destroy(ptr);
+}
+
+pub fn returnSlice(allocator: std.mem.Allocator, len: usize) ![]u32 {
+    const slice = try allocator.alloc(u32, len);
+    for (slice, 0..) |*ptr, index| ptr.* = @truncate(index);
+    return slice;
+}
+
+pub fn returnString(allocator: std.mem.Allocator, len: usize) ![]u8 {
+    const slice = try allocator.alloc(u8, len);
+    @memset(slice, 'a');
+    return slice;
+}
+
+const max_token_count = 65536;
+// room for the longest token at every position
+const max_token_len = std.fmt.count("token{d}", .{max_token_count - 1});
+var token_bytes: [max_token_count * max_token_len]u8 = undefined;
+var token_list: [max_token_count][]const u8 = undefined;
+
+pub fn returnStringList(count: usize) []const []const u8 {
+    // tokens referencing a single block of text, as a tokenizer would produce
+    var offset: usize = 0;
+    for (token_list[0..count], 0..) |*ptr, index| {
+        const token = std.fmt.bufPrint(token_bytes[offset..], "token{d}", .{index}) catch unreachable;
+        ptr.* = token;
+        offset += token.len;
+    }
+    return token_list[0..count];
+}
+
+var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+var point_list: [65536]*const Point = undefined;
+
+pub fn returnPointerList(count: usize) ![]const *const Point {
+    // objects handed out by an arena that's reused from call to call
+    _ = arena.reset(.retain_capacity);
+    const allocator = arena.allocator();
+    for (point_list[0..count], 0..) |*ptr, index| {
+        const point = try allocator.create(Point);
+        const value: f64 = @floatFromInt(index);
+        point.* = .{ .x = value, .y = -value };
+        ptr.* = point;
+    }
+    return point_list[0..count];
+}
@@ -0,0 +1,12 @@
+pub const Vector = struct { x: f64, y: f64, z: f64 };
+pub const Floats = []f64;
+
+pub fn scale(v: *Vector, factor: f64) void {
+    v.x *= factor;
+    v.y *= factor;
+    v.z *= factor;
+}
+
+pub fn double(values: []f64) void {
+    for (values) |*value| value.* *= 2;
+}
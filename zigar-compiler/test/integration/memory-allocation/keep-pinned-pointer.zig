@@ -0,0 +1,19 @@
+pub const Buffer = []u8;
+
+var ring: []u8 = &.{};
+var index: usize = 0;
+
+pub fn attach(buffer: []u8) void {
+    ring = buffer;
+    index = 0;
+}
+
+pub fn write(byte: u8) void {
+    ring[index] = byte;
+    index = (index + 1) % ring.len;
+}
+
+pub fn detach() []u8 {
+    defer ring = &.{};
+    return ring;
+}
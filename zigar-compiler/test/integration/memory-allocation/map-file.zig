@@ -0,0 +1,11 @@
+const std = @import("std");
+
+pub fn count(bytes: []const u8, byte: u8) usize {
+    return std.mem.count(u8, bytes, &[_]u8{byte});
+}
+
+pub fn capitalize(bytes: []u8) void {
+    for (bytes) |*b| {
+        b.* = std.ascii.toUpper(b.*);
+    }
+}
@@ -1,11 +1,18 @@
 import { expect } from 'chai';
+import { readFile, rm, writeFile } from 'fs/promises';
+import 'mocha-skip-if';
+import os from 'os';
+import { join } from 'path';
 import { capture } from '../capture.js';
 
 export function addTests(importModule, options) {
+  const { target } = options;
   const importTest = async (name) => {
       const url = new URL(`./${name}.zig`, import.meta.url).href;
       return importModule(url);
   };
+  // relocatable memory is not directly accessible in WebAssembly
+  const nonWASM = target !== 'wasm32';
   describe('Memory allocation', function() {
     it('should provide allocator to function returning string', async function() {
       this.timeout(300000);
@@ -49,5 +56,58 @@ export function addTests(importModule, options) {
       fixed.delete();
       expect(() => fixed.number1).to.throw();
     })
+    it('should create object in shared memory', async function() {
+      this.timeout(300000);
+      const { Vector, Floats, scale, double } = await importTest('create-shared-object');
+      const vector = new Vector({ x: 1, y: 2, z: 3 }, { shared: true });
+      expect(vector.dataView.buffer).to.be.an.instanceOf(SharedArrayBuffer);
+      scale(vector, 2);
+      expect(vector.valueOf()).to.eql({ x: 2, y: 4, z: 6 });
+      // another worker would receive the buffer through postMessage() and cast it the same way
+      const copy = Vector(vector.dataView.buffer);
+      scale(copy, 0.5);
+      expect(vector.valueOf()).to.eql({ x: 1, y: 2, z: 3 });
+      const floats = new Floats([ 1, 2, 3, 4 ], { shared: true });
+      double(floats);
+      expect([ ...floats ]).to.eql([ 2, 4, 6, 8 ]);
+      const array = new Float64Array(new SharedArrayBuffer(32));
+      array.set([ 5, 6, 7, 8 ]);
+      double(array);
+      expect([ ...array ]).to.eql([ 10, 12, 14, 16 ]);
+    })
+    skip.permanently.unless(nonWASM).
+    it('should allow Zig to keep pointer to pinned object', async function() {
+      this.timeout(300000);
+      const { Buffer, attach, write, detach, __zigar } = await importTest('keep-pinned-pointer');
+      const buffer = __zigar.pin(new Buffer(4));
+      attach(buffer);
+      for (let i = 1; i <= 6; i++) {
+        write(i);
+      }
+      expect([ ...buffer ]).to.eql([ 5, 6, 3, 4 ]);
+      expect([ ...detach() ]).to.eql([ 5, 6, 3, 4 ]);
+      __zigar.unpin(buffer);
+    })
+    skip.permanently.unless(nonWASM).
+    it('should pass memory-mapped file to function as slice', async function() {
+      this.timeout(300000);
+      const { count, capitalize, __zigar } = await importTest('map-file');
+      const path = join(os.tmpdir(), 'zigar-map-file.txt');
+      await writeFile(path, 'hello world\n'.repeat(1000));
+      try {
+        const bytes = __zigar.mapFile(path, { access: 'sequential' });
+        expect(bytes.byteLength).to.equal(12000);
+        expect(count(bytes, 0x6f)).to.equal(2000);
+        __zigar.unmapFile(bytes);
+        expect(bytes.byteLength).to.equal(0);
+        const writable = __zigar.mapFile(path, { readonly: false });
+        capitalize(writable.subarray(0, 12));
+        __zigar.unmapFile(writable);
+        const text = await readFile(path, 'utf8');
+        expect(text.slice(0, 24)).to.equal('HELLO WORLD\nhello world\n');
+      } finally {
+        await rm(path);
+      }
+    })
   })
 }
\ No newline at end of file
@@ -0,0 +1,22 @@
+const std = @import("std");
+const zigar = @import("zigar");
+
+var released = std.atomic.Value(bool).init(false);
+var wait_group: std.Thread.WaitGroup = .{};
+
+fn waitForRelease() void {
+    while (!released.load(.acquire)) {
+        std.time.sleep(1_000_000);
+    }
+}
+
+pub fn startTask(pool: zigar.ThreadPool) void {
+    released.store(false, .release);
+    pool.spawnWg(&wait_group, waitForRelease, .{});
+}
+
+pub fn finishTask() void {
+    released.store(true, .release);
+    wait_group.wait();
+    wait_group.reset();
+}
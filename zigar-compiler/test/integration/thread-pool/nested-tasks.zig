@@ -0,0 +1,19 @@
+const std = @import("std");
+const zigar = @import("zigar");
+
+fn count(pool: zigar.ThreadPool, wg: *std.Thread.WaitGroup, depth: u32, counter: *std.atomic.Value(usize)) void {
+    _ = counter.fetchAdd(1, .monotonic);
+    if (depth > 0) {
+        // tasks spawned by a task go into the worker's own queue, from which others steal
+        pool.spawnWg(wg, count, .{ pool, wg, depth - 1, counter });
+        pool.spawnWg(wg, count, .{ pool, wg, depth - 1, counter });
+    }
+}
+
+pub fn countNodes(pool: zigar.ThreadPool, depth: u32) usize {
+    var counter = std.atomic.Value(usize).init(0);
+    var wg: std.Thread.WaitGroup = .{};
+    pool.spawnWg(&wg, count, .{ pool, &wg, depth, &counter });
+    pool.waitAndWork(&wg);
+    return counter.load(.monotonic);
+}
@@ -0,0 +1,30 @@
+const std = @import("std");
+const zigar = @import("zigar");
+
+fn sumChunk(numbers: []const f64, dest: *f64) void {
+    var total: f64 = 0;
+    for (numbers) |n| total += n;
+    dest.* = total;
+}
+
+pub fn sum(pool: zigar.ThreadPool, numbers: []const f64) f64 {
+    var partials: [64]f64 = undefined;
+    const chunk_count = @min(partials.len, pool.getThreadCount() * 4);
+    const chunk_size = (numbers.len + chunk_count - 1) / chunk_count;
+    var wg: std.Thread.WaitGroup = .{};
+    var count: usize = 0;
+    var start: usize = 0;
+    while (start < numbers.len) : (start += chunk_size) {
+        const end = @min(start + chunk_size, numbers.len);
+        pool.spawnWg(&wg, sumChunk, .{ numbers[start..end], &partials[count] });
+        count += 1;
+    }
+    pool.waitAndWork(&wg);
+    var total: f64 = 0;
+    for (partials[0..count]) |n| total += n;
+    return total;
+}
+
+pub fn getThreadCount(pool: zigar.ThreadPool) usize {
+    return pool.getThreadCount();
+}
@@ -0,0 +1,59 @@
+import { expect } from 'chai';
+import 'mocha-skip-if';
+
+export function addTests(importModule, options) {
+  const { target } = options;
+  const importTest = async (name) => {
+      const url = new URL(`./${name}.zig`, import.meta.url).href;
+      return importModule(url);
+  };
+  // the pool lives in the Node addon
+  const nonWASM = target !== 'wasm32';
+  describe('Thread pool', function() {
+    skip.permanently.unless(nonWASM).
+    it('should sum numbers using the shared thread pool', async function() {
+      this.timeout(300000);
+      const { sum, getThreadCount, __zigar } = await importTest('parallel-sum');
+      __zigar.setThreadCount(4);
+      const numbers = new Float64Array(100000).map((_, i) => i);
+      expect(sum(numbers)).to.equal(99999 * 100000 / 2);
+      expect(getThreadCount()).to.equal(4);
+      const stats = __zigar.threadPoolStats();
+      expect(stats.threads).to.equal(4);
+      expect(stats.submitted).to.equal(stats.completed);
+      expect(stats.pending).to.equal(0);
+      expect(stats.active).to.equal(0);
+      __zigar.setThreadCount(2);
+      expect(__zigar.threadPoolStats()).to.be.null;
+      expect(getThreadCount()).to.equal(2);
+    })
+    skip.permanently.unless(nonWASM).
+    it('should refuse to resize the pool while it is busy', async function() {
+      this.timeout(300000);
+      const { startTask, finishTask, __zigar } = await importTest('background-task');
+      __zigar.setThreadCount(2);
+      startTask();
+      expect(() => __zigar.setThreadCount(3)).to.throw(Error)
+        .with.property('message').that.contains('busy');
+      finishTask();
+      // the worker might not have done its bookkeeping yet
+      while (__zigar.threadPoolStats().active > 0) {
+        await new Promise(r => setTimeout(r, 10));
+      }
+      expect(() => __zigar.setThreadCount(3)).to.not.throw();
+      expect(__zigar.threadPoolStats()).to.be.null;
+    })
+    skip.permanently.unless(nonWASM).
+    it('should share the pool between modules', async function() {
+      this.timeout(300000);
+      const { getThreadCount, __zigar } = await importTest('parallel-sum');
+      const { countNodes } = await importTest('nested-tasks');
+      __zigar.setThreadCount(3);
+      expect(countNodes(12)).to.equal(2 ** 13 - 1);
+      expect(getThreadCount()).to.equal(3);
+      const stats = __zigar.threadPoolStats();
+      expect(stats.threads).to.equal(3);
+      expect(stats.submitted).to.equal(2 ** 13 - 1);
+    })
+  })
+}
@@ -1,6 +1,6 @@
 import { expect, use } from 'chai';
 import { chaiPromised } from 'chai-promised';
-import { writeFileSync } from 'fs';
+import { readFileSync, statSync, writeFileSync } from 'fs';
 import os, { tmpdir } from 'os';
 import { join } from 'path';
 import { fileURLToPath } from 'url';
@@ -12,7 +12,10 @@ import {
   delay,
   deleteDirectory,
   deleteFile,
+  findExecutable,
   getDirectoryStats,
+  hashFiles,
+  linkFile,
   loadFile,
   normalizePath,
   releaseLock
@@ -59,6 +62,51 @@ describe('Utility functions', function() {
       expect(info.mtimeMs).to.be.above(1700000000000);
     })
   })
+  describe('hashFiles', function() {
+    it('should yield hash that depends on file content', async function() {
+      const path1 = join(tmpdir(), 'hash-test-1.txt');
+      const path2 = join(tmpdir(), 'hash-test-2.txt');
+      writeFileSync(path1, 'Hello');
+      writeFileSync(path2, 'World');
+      const hash1 = await hashFiles([ path1, path2 ], 'key');
+      const hash2 = await hashFiles([ path1, path2 ], 'key');
+      expect(hash1).to.equal(hash2);
+      const hash3 = await hashFiles([ path1, path2 ], 'other key');
+      expect(hash3).to.not.equal(hash1);
+      writeFileSync(path2, 'world');
+      const hash4 = await hashFiles([ path1, path2 ], 'key');
+      expect(hash4).to.not.equal(hash1);
+    })
+    it('should throw when file is missing', async function() {
+      await expect(hashFiles([ absolute('./does-not-exists.zig') ])).to.eventually.be.rejected;
+    })
+  })
+  describe('linkFile', function() {
+    it('should place file at destination', async function() {
+      const srcPath = join(tmpdir(), 'link-test-src.txt');
+      const dstPath = join(tmpdir(), 'link-test', 'dst.txt');
+      writeFileSync(srcPath, 'Hello');
+      await linkFile(srcPath, dstPath);
+      expect(readFileSync(dstPath, 'utf8')).to.equal('Hello');
+      // replace existing file
+      writeFileSync(srcPath + '2', 'World');
+      await linkFile(srcPath + '2', dstPath);
+      expect(readFileSync(dstPath, 'utf8')).to.equal('World');
+      expect(statSync(dstPath).ino).to.equal(statSync(srcPath + '2').ino);
+      await deleteDirectory(join(tmpdir(), 'link-test'));
+    })
+  })
+  describe('findExecutable', function() {
+    it('should find program in search path', async function() {
+      const info = await findExecutable('node');
+      expect(info).to.be.an('object');
+      expect(info.size).to.be.above(0);
+    })
+    it('should return undefined when program cannot be found', async function() {
+      const info = await findExecutable('zigo-does-not-exist');
+      expect(info).to.be.undefined;
+    })
+  })
   describe('delay', function() {
     it('should pause execution for the specified amount of time', async function() {
       const start = new Date;
@@ -0,0 +1,46 @@
+const std = @import("std");
+const cfg = @import("./build-cfg.zig");
+
+// builds a shared library for each module listed in build-cfg.zig; the steps are run in parallel
+pub fn build(b: *std.Build) void {
+    const target = b.standardTargetOptions(.{});
+    const optimize = b.standardOptimizeOption(.{});
+    inline for (cfg.modules) |m| {
+        const lib = b.addSharedLibrary(.{
+            .name = m.module_name,
+            .root_source_file = .{ .cwd_relative = m.stub_path },
+            .target = target,
+            .optimize = optimize,
+        });
+        const zigar = b.createModule(.{
+            .root_source_file = .{ .cwd_relative = b.pathJoin(&.{ std.fs.path.dirname(m.stub_path).?, "zigar.zig" }) },
+        });
+        const imports = [_]std.Build.Module.Import{
+            .{ .name = "zigar", .module = zigar },
+        };
+        const mod = b.createModule(.{
+            .root_source_file = .{ .cwd_relative = m.module_path },
+            .imports = &imports,
+        });
+        mod.addIncludePath(.{ .cwd_relative = m.module_dir });
+        lib.root_module.addImport("module", mod);
+        if (m.is_wasm) {
+            // WASM needs to be compiled as exe
+            lib.kind = .exe;
+            lib.linkage = .static;
+            lib.entry = .disabled;
+            lib.rdynamic = true;
+            lib.wasi_exec_model = .reactor;
+        }
+        if (m.use_libc) {
+            lib.linkLibC();
+        }
+        const wf = switch (@hasDecl(std.Build, "addUpdateSourceFiles")) {
+            true => b.addUpdateSourceFiles(),
+            false => b.addWriteFiles(),
+        };
+        wf.addCopyFileToSource(lib.getEmittedBin(), m.output_path);
+        wf.step.dependOn(&lib.step);
+        b.getInstallStep().dependOn(&wf.step);
+    }
+}
@@ -10,7 +10,13 @@ pub fn build(b: *std.Build) void {
         .target = target,
         .optimize = optimize,
     });
-    const imports = .{};
+    // let the module access types like ThreadPool through @import("zigar")
+    const zigar = b.createModule(.{
+        .root_source_file = .{ .cwd_relative = b.pathJoin(&.{ std.fs.path.dirname(cfg.stub_path).?, "zigar.zig" }) },
+    });
+    const imports = [_]std.Build.Module.Import{
+        .{ .name = "zigar", .module = zigar },
+    };
     const mod = b.createModule(.{
         .root_source_file = .{ .cwd_relative = cfg.module_path },
         .imports = &imports,
@@ -65,6 +65,7 @@ fn addMembers(ctx: anytype, structure: Value, comptime td: TypeData) !void {
         .error_union => try addErrorUnionMembers(ctx, structure, td),
         .optional => try addOptionalMembers(ctx, structure, td),
         .vector => try addVectorMember(ctx, structure, td),
+        .function => try addCallbackMember(ctx, structure, td),
         else => {},
     }
 }
@@ -142,6 +143,18 @@ fn addPointerMember(ctx: anytype, structure: Value, comptime td: TypeData) !void
     }, false);
 }
 
+fn addCallbackMember(ctx: anytype, structure: Value, comptime td: TypeData) !void {
+    // the arg struct tells the runtime how to decode the arguments
+    const FT = @typeInfo(td.Type).Pointer.child;
+    try ctx.host.attachMember(structure, .{
+        .member_type = td.getMemberType(false),
+        .bit_size = td.getBitSize(),
+        .byte_size = td.getByteSize(),
+        .slot = 0,
+        .structure = try getStructure(ctx, types.ArgumentStruct(FT)),
+    }, false);
+}
+
 fn addStructMembers(ctx: anytype, structure: Value, comptime td: TypeData) !void {
     const st = @typeInfo(td.Type).Struct;
     inline for (st.fields, 0..) |field, index| {
@@ -312,6 +325,10 @@ fn addStaticMembers(ctx: anytype, structure: Value, comptime td: TypeData) !void
                     const decl_value = decl_ptr.*;
                     const DT = @TypeOf(decl_value);
                     const is_supported = comptime check: {
+                        if (@typeInfo(DT) == .Fn) {
+                            // functions are exported as methods
+                            break :check false;
+                        }
                         if (DT == type) {
                             // export type only if it's supported
                             // not sure why the following line is necessary
@@ -399,6 +416,7 @@ fn addMethods(ctx: anytype, structure: Value, comptime td: TypeData) !void {
     }
     return switch (@typeInfo(td.Type)) {
         inline .Struct, .Union, .Enum, .Opaque => |st| {
+            comptime var has_next = false;
             inline for (st.decls) |decl| {
                 const decl_value = @field(td.Type, decl.name);
                 const DT = @TypeOf(decl_value);
@@ -410,7 +428,7 @@ fn addMethods(ctx: anytype, structure: Value, comptime td: TypeData) !void {
                             }
                             inline for (f.params) |param| {
                                 if (param.type) |PT| {
-                                    if (PT != std.mem.Allocator) {
+                                    if (!types.isHostProvided(PT)) {
                                         const param_td = ctx.tdb.get(PT);
                                         if (param_td.hasUnsupported() or param_td.isComptimeOnly()) {
                                             break :check false;
@@ -451,16 +469,192 @@ fn addMethods(ctx: anytype, structure: Value, comptime td: TypeData) !void {
                                 .thunk_id = thunk_id,
                                 .structure = try getStructure(ctx, types.ArgumentStruct(DT)),
                             }, is_static_only);
+                            if (comptime std.mem.eql(u8, decl.name, "next")) {
+                                has_next = true;
+                            }
                         }
                     },
                     else => {},
                 }
             }
+            if (comptime has_next and td.isIterator() and types.isPrefetching(td.Type) and !hasPointerItem(ctx, td.Type)) {
+                // hidden method used by the runtime to pull items in batches; items that can point
+                // into memory owned by the iterator would be overwritten by the time they're used
+                const function = types.NextBatch(td.Type).function;
+                const thunk_id = @intFromPtr(createThunk(@TypeOf(ctx.host), function));
+                try ctx.host.attachMethod(structure, .{
+                    .name = "@next",
+                    .thunk_id = thunk_id,
+                    .structure = try getStructure(ctx, types.ArgumentStruct(@TypeOf(function))),
+                }, false);
+            }
+        },
+        .Pointer => |pt| if (comptime td.isCallback()) {
+            // hidden methods used by the runtime to attach JS functions to trampolines
+            const Table = CallbackTable(@TypeOf(ctx.host), pt.child);
+            inline for (.{ .{ "@bind", Table.bind }, .{ "@unbind", Table.unbind } }) |entry| {
+                const thunk_id = @intFromPtr(createThunk(@TypeOf(ctx.host), entry[1]));
+                try ctx.host.attachMethod(structure, .{
+                    .name = entry[0],
+                    .thunk_id = thunk_id,
+                    .structure = try getStructure(ctx, types.ArgumentStruct(types.CallbackBinder)),
+                }, true);
+            }
         },
         else => {},
     };
 }
 
+fn hasPointerItem(ctx: anytype, comptime T: type) bool {
+    const IT = types.NextMethodReturnType(@TypeOf(T.next), T).?;
+    return ctx.tdb.get(IT).hasPointer();
+}
+
+fn CallbackTable(comptime HostT: type, comptime FT: type) type {
+    const f = @typeInfo(FT).Fn;
+    const ArgStruct = types.ArgumentStruct(FT);
+    const Args = std.meta.ArgsTuple(FT);
+    const cc = f.calling_convention;
+    return struct {
+        // a function pointer carries no context, so each binding needs a function of its own
+        const capacity = 64;
+        var handles = [_]usize{0} ** capacity;
+        // number of threads in the middle of forwarding a call through each trampoline
+        var active = [_]usize{0} ** capacity;
+
+        fn Trampoline(comptime index: usize) type {
+            const P = struct {
+                fn T(comptime i: usize) type {
+                    return if (i < f.params.len) f.params[i].type.? else void;
+                }
+            }.T;
+            return struct {
+                fn forward(args: Args) void {
+                    // can be called from any thread; JS is not touched here
+                    _ = @atomicRmw(usize, &active[index], .Add, 1, .seq_cst);
+                    defer _ = @atomicRmw(usize, &active[index], .Sub, 1, .seq_cst);
+                    const handle = @atomicLoad(usize, &handles[index], .seq_cst);
+                    if (handle == 0) {
+                        // binding has been released
+                        return;
+                    }
+                    var arg_struct: ArgStruct = undefined;
+                    inline for (0..f.params.len) |i| {
+                        @field(arg_struct, std.fmt.comptimePrint("{d}", .{i})) = args[i];
+                    }
+                    const bytes: []const u8 = std.mem.asBytes(&arg_struct);
+                    HostT.queueCallback(handle, bytes.ptr, bytes.len) catch {};
+                }
+
+                fn call0() callconv(cc) void {
+                    forward(.{});
+                }
+
+                fn call1(a0: P(0)) callconv(cc) void {
+                    forward(.{a0});
+                }
+
+                fn call2(a0: P(0), a1: P(1)) callconv(cc) void {
+                    forward(.{ a0, a1 });
+                }
+
+                fn call3(a0: P(0), a1: P(1), a2: P(2)) callconv(cc) void {
+                    forward(.{ a0, a1, a2 });
+                }
+
+                fn call4(a0: P(0), a1: P(1), a2: P(2), a3: P(3)) callconv(cc) void {
+                    forward(.{ a0, a1, a2, a3 });
+                }
+
+                fn call5(a0: P(0), a1: P(1), a2: P(2), a3: P(3), a4: P(4)) callconv(cc) void {
+                    forward(.{ a0, a1, a2, a3, a4 });
+                }
+
+                fn call6(a0: P(0), a1: P(1), a2: P(2), a3: P(3), a4: P(4), a5: P(5)) callconv(cc) void {
+                    forward(.{ a0, a1, a2, a3, a4, a5 });
+                }
+
+                fn call7(a0: P(0), a1: P(1), a2: P(2), a3: P(3), a4: P(4), a5: P(5), a6: P(6)) callconv(cc) void {
+                    forward(.{ a0, a1, a2, a3, a4, a5, a6 });
+                }
+
+                fn call8(a0: P(0), a1: P(1), a2: P(2), a3: P(3), a4: P(4), a5: P(5), a6: P(6), a7: P(7)) callconv(cc) void {
+                    forward(.{ a0, a1, a2, a3, a4, a5, a6, a7 });
+                }
+
+                const function: *const FT = switch (f.params.len) {
+                    0 => call0,
+                    1 => call1,
+                    2 => call2,
+                    3 => call3,
+                    4 => call4,
+                    5 => call5,
+                    6 => call6,
+                    7 => call7,
+                    8 => call8,
+                    else => @compileError("Too many arguments for callback"),
+                };
+            };
+        }
+
+        const trampolines = init: {
+            var list: [capacity]*const FT = undefined;
+            for (0..capacity) |index| {
+                list[index] = Trampoline(index).function;
+            }
+            break :init list;
+        };
+
+        fn bind(handle: usize) usize {
+            for (&handles, 0..) |*ptr, index| {
+                if (@cmpxchgStrong(usize, ptr, 0, handle, .acq_rel, .monotonic) == null) {
+                    return @intFromPtr(trampolines[index]);
+                }
+            }
+            // all trampolines are in use
+            return 0;
+        }
+
+        fn unbind(address: usize) usize {
+            for (trampolines, 0..) |trampoline, index| {
+                if (@intFromPtr(trampoline) == address) {
+                    const handle = @atomicRmw(usize, &handles[index], .Xchg, 0, .seq_cst);
+                    // wait for calls that have already read the handle, so the caller can release
+                    // it once we return (queueCallback() never blocks, as the queue has no limit)
+                    while (@atomicLoad(usize, &active[index], .seq_cst) != 0) {
+                        std.atomic.spinLoopHint();
+                    }
+                    return handle;
+                }
+            }
+            return 0;
+        }
+    };
+}
+
+test "CallbackTable" {
+    const Host = struct {
+        var received: usize = 0;
+
+        pub fn queueCallback(handle: usize, _: [*]const u8, _: usize) !void {
+            received = handle;
+        }
+    };
+    const Table = CallbackTable(Host, fn (i32, bool) void);
+    const address = Table.bind(1234);
+    try expect(address != 0);
+    const function: *const fn (i32, bool) void = @ptrFromInt(address);
+    function(5, true);
+    try expect(Host.received == 1234);
+    try expect(Table.unbind(address) == 1234);
+    Host.received = 0;
+    function(5, true);
+    try expect(Host.received == 0);
+    for (Table.active) |count| {
+        try expect(count == 0);
+    }
+}
+
 fn createThunk(comptime HostT: type, comptime function: anytype) types.ThunkType(function) {
     const FT = @TypeOf(function);
     const f = @typeInfo(FT).Fn;
@@ -476,6 +670,8 @@ fn createThunk(comptime HostT: type, comptime function: anytype) types.ThunkType
             inline for (fields, 0..) |field, i| {
                 if (field.type == std.mem.Allocator) {
                     args[i] = createAllocator(&host);
+                } else if (comptime types.isThreadPool(field.type)) {
+                    args[i] = try host.getThreadPool(field.type);
                 } else {
                     const name = std.fmt.comptimePrint("{d}", .{index});
                     // get the argument only if it isn't empty
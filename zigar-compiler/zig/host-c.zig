@@ -2,6 +2,7 @@ const std = @import("std");
 const builtin = @import("builtin");
 const exporter = @import("./exporter.zig");
 const types = @import("./types.zig");
+const thread_pool = @import("./thread-pool.zig");
 const expect = std.testing.expect;
 
 const Value = types.Value;
@@ -218,6 +219,21 @@ pub const Host = struct {
         const dv = try self.captureView(memory);
         try self.writeToConsole(dv);
     }
+
+    // called from arbitrary threads, hence the lack of a call context
+    pub fn queueCallback(handle: usize, bytes: [*]const u8, len: usize) !void {
+        if (imports.queue_callback(handle, bytes, len) != .ok) {
+            return Error.unable_to_queue_callback;
+        }
+    }
+
+    pub fn getThreadPool(self: Host, comptime T: type) !T {
+        var pool: ThreadPoolC = undefined;
+        if (imports.get_thread_pool(self.context, &pool) != .ok) {
+            return Error.unable_to_obtain_thread_pool;
+        }
+        return .{ .ptr = pool.ptr, .vtable = @ptrCast(pool.vtable) };
+    }
 };
 
 // allocator for fixed memory
@@ -279,6 +295,72 @@ fn freeExternMemory(_: MemoryType, memory: *const Memory) callconv(.C) Result {
     }
 }
 
+// the pool is created by whichever module first needs it, then shared with the others through
+// the addon; the first five functions must match ThreadPool.VTable in zigar.zig
+const ThreadPoolVTable = extern struct {
+    spawn: *const fn (*anyopaque, *thread_pool.Task) callconv(.C) bool,
+    run_pending: *const fn (*anyopaque) callconv(.C) bool,
+    get_thread_count: *const fn (*anyopaque) callconv(.C) usize,
+    allocate: *const fn (*anyopaque, usize, usize) callconv(.C) ?[*]u8,
+    free: *const fn (*anyopaque, [*]u8, usize, usize) callconv(.C) void,
+    get_stats: *const fn (*anyopaque, *thread_pool.Stats) callconv(.C) void,
+    shut_down: *const fn (*anyopaque) callconv(.C) void,
+};
+const ThreadPoolC = extern struct {
+    ptr: *anyopaque,
+    vtable: *const ThreadPoolVTable,
+};
+
+const thread_pool_vtable = struct {
+    fn cast(ptr: *anyopaque) *thread_pool.ThreadPool {
+        return @ptrCast(@alignCast(ptr));
+    }
+
+    fn spawn(ptr: *anyopaque, task: *thread_pool.Task) callconv(.C) bool {
+        return cast(ptr).spawn(task);
+    }
+
+    fn runPending(ptr: *anyopaque) callconv(.C) bool {
+        return cast(ptr).runPending();
+    }
+
+    fn getThreadCount(ptr: *anyopaque) callconv(.C) usize {
+        return cast(ptr).workers.len;
+    }
+
+    fn allocate(ptr: *anyopaque, len: usize, alignment: usize) callconv(.C) ?[*]u8 {
+        return cast(ptr).allocate(len, alignment);
+    }
+
+    fn free(ptr: *anyopaque, bytes: [*]u8, len: usize, alignment: usize) callconv(.C) void {
+        cast(ptr).free(bytes, len, alignment);
+    }
+
+    fn getStats(ptr: *anyopaque, dest: *thread_pool.Stats) callconv(.C) void {
+        dest.* = cast(ptr).getStats();
+    }
+
+    fn shutDown(ptr: *anyopaque) callconv(.C) void {
+        cast(ptr).shutDown();
+    }
+
+    const instance: ThreadPoolVTable = .{
+        .spawn = spawn,
+        .run_pending = runPending,
+        .get_thread_count = getThreadCount,
+        .allocate = allocate,
+        .free = free,
+        .get_stats = getStats,
+        .shut_down = shutDown,
+    };
+};
+
+fn createThreadPool(thread_count: usize, dest: *ThreadPoolC) callconv(.C) Result {
+    const pool = thread_pool.ThreadPool.create(allocator, thread_count) catch return .failure;
+    dest.* = .{ .ptr = pool, .vtable = &thread_pool_vtable.instance };
+    return .ok;
+}
+
 pub fn overrideWrite(bytes: [*]const u8, len: usize) callconv(.C) Result {
     if (initial_context) |context| {
         const host = Host.init(context, null);
@@ -326,6 +408,8 @@ const Imports = extern struct {
     end_structure: *const fn (Call, Value) callconv(.C) Result,
     create_template: *const fn (Call, ?Value, *Value) callconv(.C) Result,
     write_to_console: *const fn (Call, Value) callconv(.C) Result,
+    queue_callback: *const fn (usize, [*]const u8, usize) callconv(.C) Result,
+    get_thread_pool: *const fn (Call, *ThreadPoolC) callconv(.C) Result,
 };
 var imports: Imports = undefined;
 
@@ -337,6 +421,7 @@ const Exports = extern struct {
     run_thunk: *const fn (Call, usize, *anyopaque, *?Value) callconv(.C) Result,
     run_variadic_thunk: *const fn (Call, usize, *anyopaque, *const anyopaque, usize, *?Value) callconv(.C) Result,
     override_write: *const fn ([*]const u8, usize) callconv(.C) Result,
+    create_thread_pool: *const fn (usize, *ThreadPoolC) callconv(.C) Result,
 };
 
 const ModuleAttributes = packed struct(u32) {
@@ -365,7 +450,7 @@ pub fn createGetFactoryThunk(comptime T: type) fn (*usize) callconv(.C) Result {
 
 pub fn createModule(comptime T: type) Module {
     return .{
-        .version = 4,
+        .version = 6,
         .attributes = .{
             .little_endian = builtin.target.cpu.arch.endian() == .little,
             .runtime_safety = switch (builtin.mode) {
@@ -381,6 +466,7 @@ pub fn createModule(comptime T: type) Module {
             .run_thunk = runThunk,
             .run_variadic_thunk = runVariadicThunk,
             .override_write = overrideWrite,
+            .create_thread_pool = createThreadPool,
         },
     };
 }
@@ -399,6 +485,6 @@ test "createModule" {
         }
     };
     const module = createModule(Test);
-    try expect(module.version == 4);
+    try expect(module.version == 6);
     try expect(module.attributes.little_endian == (builtin.target.cpu.arch.endian() == .little));
 }
@@ -282,6 +282,15 @@ pub const Host = struct {
         return _createTemplate(dv) orelse
             Error.unable_to_create_structure_template;
     }
+
+    pub fn queueCallback(_: usize, _: [*]const u8, _: usize) !void {
+        // there's no thread-safe way to reach JavaScript from WebAssembly
+        return Error.unable_to_queue_callback;
+    }
+
+    pub fn getThreadPool(_: Host, comptime T: type) !T {
+        return Error.unable_to_obtain_thread_pool;
+    }
 };
 
 pub fn runThunk(thunk_id: usize, arg_ptr: *anyopaque) ?Value {
@@ -0,0 +1,317 @@
+const std = @import("std");
+const expect = std.testing.expect;
+
+// layout must match ThreadPool.Task in zigar.zig
+pub const Task = extern struct {
+    run: *const fn (*Task) callconv(.C) void,
+    prev: ?*Task = null,
+    next: ?*Task = null,
+};
+
+pub const Stats = extern struct {
+    thread_count: usize,
+    submitted: usize,
+    completed: usize,
+    stolen: usize,
+    pending: usize,
+    sleeps: usize,
+    active: usize,
+};
+
+// doubly-linked list of tasks; the owner pushes and pops at the front while other threads
+// steal from the back, so that the oldest (and typically largest) piece of work gets moved
+const Queue = struct {
+    mutex: std.Thread.Mutex = .{},
+    head: ?*Task = null,
+    tail: ?*Task = null,
+
+    fn push(self: *@This(), task: *Task) void {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        task.prev = null;
+        task.next = self.head;
+        if (self.head) |head| {
+            head.prev = task;
+        } else {
+            self.tail = task;
+        }
+        self.head = task;
+    }
+
+    fn pop(self: *@This()) ?*Task {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        const task = self.head orelse return null;
+        self.head = task.next;
+        if (self.head) |head| {
+            head.prev = null;
+        } else {
+            self.tail = null;
+        }
+        return task;
+    }
+
+    fn steal(self: *@This()) ?*Task {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        const task = self.tail orelse return null;
+        self.tail = task.prev;
+        if (self.tail) |tail| {
+            tail.next = null;
+        } else {
+            self.head = null;
+        }
+        return task;
+    }
+};
+
+const Worker = struct {
+    pool: *ThreadPool,
+    index: usize,
+    queue: Queue = .{},
+    thread: std.Thread = undefined,
+};
+
+threadlocal var current_worker: ?*Worker = null;
+
+pub const ThreadPool = struct {
+    allocator: std.mem.Allocator,
+    workers: []Worker,
+    // tasks submitted by threads outside the pool
+    injected: Queue = .{},
+    pending: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    // tasks taken from the queues that haven't finished yet
+    active: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    // threads inside spawn() that have seen the pool running
+    spawning: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    sleeping: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    shutting_down: std.atomic.Value(bool) = std.atomic.Value(bool).init(false),
+    idle_mutex: std.Thread.Mutex = .{},
+    idle_cond: std.Thread.Condition = .{},
+    submitted: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    completed: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    stolen: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+    sleeps: std.atomic.Value(usize) = std.atomic.Value(usize).init(0),
+
+    pub fn create(allocator: std.mem.Allocator, thread_count: usize) !*@This() {
+        const count = if (thread_count != 0) thread_count else std.Thread.getCpuCount() catch 1;
+        const self = try allocator.create(@This());
+        errdefer allocator.destroy(self);
+        self.* = .{ .allocator = allocator, .workers = try allocator.alloc(Worker, count) };
+        errdefer allocator.free(self.workers);
+        for (self.workers, 0..) |*worker, index| {
+            worker.* = .{ .pool = self, .index = index };
+        }
+        var started: usize = 0;
+        errdefer {
+            self.shutting_down.store(true, .seq_cst);
+            self.wakeAll();
+            for (self.workers[0..started]) |*worker| worker.thread.join();
+        }
+        for (self.workers) |*worker| {
+            worker.thread = try std.Thread.spawn(.{}, run, .{worker});
+            started += 1;
+        }
+        return self;
+    }
+
+    // stop the workers without freeing the pool, so that code still holding onto it can safely
+    // call spawn(), which fails from then on; workers finish whatever is in the queues first
+    pub fn shutDown(self: *@This()) void {
+        if (self.shutting_down.swap(true, .seq_cst)) {
+            return;
+        }
+        // a task pushed by a spawn() that got past the check has to land in a queue before the
+        // workers are told to exit
+        while (self.spawning.load(.seq_cst) > 0) {
+            std.Thread.yield() catch {};
+        }
+        self.wakeAll();
+        for (self.workers) |*worker| worker.thread.join();
+    }
+
+    pub fn destroy(self: *@This()) void {
+        self.shutDown();
+        const allocator = self.allocator;
+        allocator.free(self.workers);
+        allocator.destroy(self);
+    }
+
+    pub fn spawn(self: *@This(), task: *Task) bool {
+        _ = self.spawning.fetchAdd(1, .seq_cst);
+        defer _ = self.spawning.fetchSub(1, .seq_cst);
+        if (self.shutting_down.load(.seq_cst)) {
+            return false;
+        }
+        // bump the count first so that it never drops below the number of queued tasks
+        _ = self.submitted.fetchAdd(1, .monotonic);
+        _ = self.pending.fetchAdd(1, .seq_cst);
+        if (current_worker) |worker| {
+            if (worker.pool == self) {
+                // keep work spawned by a task close to it
+                worker.queue.push(task);
+            } else {
+                self.injected.push(task);
+            }
+        } else {
+            self.injected.push(task);
+        }
+        if (self.sleeping.load(.seq_cst) > 0) {
+            self.idle_mutex.lock();
+            defer self.idle_mutex.unlock();
+            self.idle_cond.signal();
+        }
+        return true;
+    }
+
+    pub fn runPending(self: *@This()) bool {
+        const worker: ?*Worker = if (current_worker) |w| (if (w.pool == self) w else null) else null;
+        const task = self.take(worker) orelse return false;
+        self.execute(task);
+        return true;
+    }
+
+    // memory for closures of tasks spawned through ThreadPool.spawnWg() in zigar.zig
+    pub fn allocate(self: *@This(), len: usize, alignment: usize) ?[*]u8 {
+        return self.allocator.rawAlloc(len, std.math.log2_int(usize, alignment), @returnAddress());
+    }
+
+    pub fn free(self: *@This(), bytes: [*]u8, len: usize, alignment: usize) void {
+        self.allocator.rawFree(bytes[0..len], std.math.log2_int(usize, alignment), @returnAddress());
+    }
+
+    pub fn getStats(self: *@This()) Stats {
+        return .{
+            .thread_count = self.workers.len,
+            .submitted = self.submitted.load(.monotonic),
+            .completed = self.completed.load(.monotonic),
+            .stolen = self.stolen.load(.monotonic),
+            .pending = self.pending.load(.monotonic),
+            .sleeps = self.sleeps.load(.monotonic),
+            .active = self.active.load(.monotonic),
+        };
+    }
+
+    fn take(self: *@This(), worker: ?*Worker) ?*Task {
+        if (self.pending.load(.seq_cst) == 0) {
+            return null;
+        }
+        const task = get: {
+            if (worker) |w| {
+                if (w.queue.pop()) |task| break :get task;
+            }
+            if (self.injected.steal()) |task| break :get task;
+            // go through the other workers, starting with the next one
+            const start = if (worker) |w| w.index + 1 else 0;
+            for (0..self.workers.len) |i| {
+                const victim = &self.workers[(start + i) % self.workers.len];
+                if (victim == worker) continue;
+                if (victim.queue.steal()) |task| {
+                    _ = self.stolen.fetchAdd(1, .monotonic);
+                    break :get task;
+                }
+            }
+            return null;
+        };
+        // count the task as active before it stops being pending, so that a busy pool never
+        // appears idle
+        _ = self.active.fetchAdd(1, .seq_cst);
+        _ = self.pending.fetchSub(1, .seq_cst);
+        return task;
+    }
+
+    fn execute(self: *@This(), task: *Task) void {
+        task.run(task);
+        _ = self.completed.fetchAdd(1, .monotonic);
+        _ = self.active.fetchSub(1, .seq_cst);
+    }
+
+    fn wakeAll(self: *@This()) void {
+        self.idle_mutex.lock();
+        defer self.idle_mutex.unlock();
+        self.idle_cond.broadcast();
+    }
+
+    fn run(worker: *Worker) void {
+        const self = worker.pool;
+        current_worker = worker;
+        while (true) {
+            if (self.take(worker)) |task| {
+                self.execute(task);
+                continue;
+            }
+            self.idle_mutex.lock();
+            defer self.idle_mutex.unlock();
+            // spawn() checks the sleeping count after bumping pending, so one side always sees
+            // the other's change and a wake-up cannot be lost
+            _ = self.sleeping.fetchAdd(1, .seq_cst);
+            defer _ = self.sleeping.fetchSub(1, .seq_cst);
+            if (self.pending.load(.seq_cst) > 0) {
+                continue;
+            }
+            if (self.shutting_down.load(.seq_cst)) {
+                break;
+            }
+            _ = self.sleeps.fetchAdd(1, .monotonic);
+            self.idle_cond.wait(&self.idle_mutex);
+        }
+    }
+};
+
+test "ThreadPool" {
+    const Test = struct {
+        var counter = std.atomic.Value(usize).init(0);
+
+        fn run(_: *Task) callconv(.C) void {
+            _ = counter.fetchAdd(1, .monotonic);
+        }
+    };
+    const pool = try ThreadPool.create(std.testing.allocator, 4);
+    var tasks: [1000]Task = undefined;
+    for (&tasks) |*task| {
+        task.* = .{ .run = Test.run };
+        try expect(pool.spawn(task));
+    }
+    // help out from this thread
+    while (pool.runPending()) {}
+    const stats = pool.getStats();
+    try expect(stats.thread_count == 4);
+    try expect(stats.submitted == tasks.len);
+    pool.destroy();
+    try expect(Test.counter.load(.monotonic) == tasks.len);
+}
+
+test "ThreadPool.shutDown" {
+    const Test = struct {
+        var counter = std.atomic.Value(usize).init(0);
+
+        fn run(_: *Task) callconv(.C) void {
+            _ = counter.fetchAdd(1, .monotonic);
+        }
+    };
+    const pool = try ThreadPool.create(std.testing.allocator, 2);
+    defer pool.destroy();
+    var tasks: [100]Task = undefined;
+    for (&tasks) |*task| {
+        task.* = .{ .run = Test.run };
+        try expect(pool.spawn(task));
+    }
+    pool.shutDown();
+    // queued tasks are run before the workers exit
+    try expect(Test.counter.load(.monotonic) == tasks.len);
+    const stats = pool.getStats();
+    try expect(stats.pending == 0);
+    try expect(stats.active == 0);
+    // the pool is still usable, but no longer accepts tasks
+    var task: Task = .{ .run = Test.run };
+    try expect(!pool.spawn(&task));
+    try expect(!pool.runPending());
+}
+
+test "ThreadPool.allocate" {
+    const pool = try ThreadPool.create(std.testing.allocator, 1);
+    defer pool.destroy();
+    const bytes = pool.allocate(48, 16) orelse return error.OutOfMemory;
+    try expect(@intFromPtr(bytes) % 16 == 0);
+    pool.free(bytes, 48, 16);
+}
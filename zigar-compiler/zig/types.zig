@@ -21,6 +21,8 @@ pub const Error = error{
     unable_to_add_structure_template,
     unable_to_define_structure,
     unable_to_write_to_console,
+    unable_to_queue_callback,
+    unable_to_obtain_thread_pool,
     too_many_arguments,
 };
 
@@ -322,6 +324,7 @@ pub const TypeAttributes = packed struct {
     is_slice: bool = false,
     has_pointer: bool = false,
     has_unsupported: bool = false,
+    is_callback: bool = false,
     known: bool = false,
 };
 
@@ -347,6 +350,8 @@ pub const TypeData = struct {
             }
         else if (self.attrs.is_slice)
             .slice
+        else if (self.attrs.is_callback)
+            .function
         else switch (@typeInfo(self.Type)) {
             .Bool,
             .Int,
@@ -616,6 +621,10 @@ pub const TypeData = struct {
         return self.attrs.is_arguments;
     }
 
+    pub fn isCallback(comptime self: @This()) bool {
+        return self.attrs.is_callback;
+    }
+
     pub fn isSupported(comptime self: @This()) bool {
         return self.attrs.is_supported;
     }
@@ -779,7 +788,7 @@ test "TypeData.getContentBitOffset" {
     try expectCT(TypeData.getContentBitOffset(.{ .Type = Union }) == 0);
 }
 
-fn NextMethodReturnType(comptime FT: type, comptime T: type) ?type {
+pub fn NextMethodReturnType(comptime FT: type, comptime T: type) ?type {
     const f = @typeInfo(FT).Fn;
     if (f.return_type) |RT| {
         const param_match = switch (f.params.len) {
@@ -847,6 +856,115 @@ test "NextMethodReturnType" {
     try expect(T5 == null);
 }
 
+// items pulled ahead of time are lost when a loop exits early, so iterators have to opt into
+// having their items fetched in batches by declaring `pub const zigar_prefetch = true`
+pub fn isPrefetching(comptime T: type) bool {
+    return switch (@typeInfo(T)) {
+        .Struct, .Union, .Opaque => @hasDecl(T, "zigar_prefetch") and @field(T, "zigar_prefetch") == true,
+        else => false,
+    };
+}
+
+test "isPrefetching" {
+    const S1 = struct {
+        pub const zigar_prefetch = true;
+    };
+    const S2 = struct {
+        pub const zigar_prefetch = false;
+    };
+    try expect(isPrefetching(S1));
+    try expect(isPrefetching(S2) == false);
+    try expect(isPrefetching(std.mem.SplitIterator(u8, .sequence)) == false);
+    try expect(isPrefetching(i32) == false);
+}
+
+pub fn NextBatch(comptime T: type) type {
+    const next = @field(T, "next");
+    const FT = @TypeOf(next);
+    const f = @typeInfo(FT).Fn;
+    const PT = NextMethodReturnType(FT, T).?;
+    const ET = switch (@typeInfo(f.return_type.?)) {
+        .ErrorUnion => |eu| eu.error_set!void,
+        else => void,
+    };
+    // keep the batch within a few pages
+    const capacity = if (@sizeOf(PT) == 0) 64 else @max(1, @min(64, 4096 / @sizeOf(PT)));
+    const Batch = struct {
+        // optional so that unused slots do not hold invalid pointers
+        items: [capacity]?PT = [_]?PT{null} ** capacity,
+        len: usize = 0,
+        end: bool = false,
+        err: ET = {},
+    };
+    return struct {
+        pub const Result = Batch;
+
+        fn fill(self: *T, allocator: ?std.mem.Allocator, max: usize) Batch {
+            var batch: Batch = .{};
+            const count = @min(max, capacity);
+            while (batch.len < count) {
+                const result = if (comptime f.params.len == 2) next(self, allocator.?) else next(self);
+                // an error ends the batch; it's thrown once the items before it have been consumed
+                const item = if (comptime ET == void) result else result catch |err| {
+                    batch.err = err;
+                    break;
+                };
+                if (item) |value| {
+                    batch.items[batch.len] = value;
+                    batch.len += 1;
+                } else {
+                    batch.end = true;
+                    break;
+                }
+            }
+            return batch;
+        }
+
+        fn nextWithAllocator(self: *T, allocator: std.mem.Allocator, max: usize) Batch {
+            return fill(self, allocator, max);
+        }
+
+        fn nextWithoutAllocator(self: *T, max: usize) Batch {
+            return fill(self, null, max);
+        }
+
+        pub const function = if (f.params.len == 2) nextWithAllocator else nextWithoutAllocator;
+    };
+}
+
+test "NextBatch" {
+    const S = struct {
+        index: i32 = 0,
+
+        pub fn next(self: *@This()) !?i32 {
+            defer self.index += 1;
+            return switch (self.index) {
+                0...2 => self.index,
+                3 => error.Unlucky,
+                else => null,
+            };
+        }
+    };
+    var s: S = .{};
+    const batch1 = NextBatch(S).function(&s, 2);
+    try expect(batch1.len == 2);
+    try expect(batch1.items[1].? == 1);
+    try expect(batch1.end == false);
+    const batch2 = NextBatch(S).function(&s, 10);
+    try expect(batch2.len == 1);
+    try expect(batch2.items[0].? == 2);
+    try std.testing.expectError(error.Unlucky, batch2.err);
+    const batch3 = NextBatch(S).function(&s, 10);
+    try expect(batch3.len == 0);
+    try expect(batch3.end == true);
+}
+
+// type of the functions that attach JS functions to callback pointers and detach them
+pub const CallbackBinder = fn (usize) usize;
+
+// trampolines can only be generated for a limited number of arguments
+pub const max_callback_args = 8;
+
 pub const TypeDataCollector = struct {
     types: ComptimeList(TypeData),
     functions: ComptimeList(type),
@@ -911,7 +1029,7 @@ pub const TypeDataCollector = struct {
                 if (!f.is_generic) {
                     inline for (f.params) |param| {
                         if (param.type) |PT| {
-                            if (PT != std.mem.Allocator) {
+                            if (!isHostProvided(PT)) {
                                 self.add(PT);
                             }
                         }
@@ -946,10 +1064,28 @@ pub const TypeDataCollector = struct {
             },
             else => {},
         }
+        // add function that fetches items from iterators in batches
+        switch (@typeInfo(T)) {
+            .Struct, .Union, .Opaque => if (comptime TypeData.isIterator(.{ .Type = T }) and isPrefetching(T)) {
+                const function = NextBatch(T).function;
+                self.add(@TypeOf(function));
+                self.addTypeOf(function);
+            },
+            else => {},
+        }
         // add other implicit types
         switch (@typeInfo(T)) {
             .NoReturn => self.add(void),
             .Pointer => |pt| {
+                switch (@typeInfo(pt.child)) {
+                    .Fn => |f| if (!f.is_generic) {
+                        // arguments of callbacks are passed to JS in an arg struct
+                        self.functions = self.functions.concat(pt.child);
+                        self.add(CallbackBinder);
+                        self.functions = self.functions.concat(CallbackBinder);
+                    },
+                    else => {},
+                }
                 const td = self.at(index);
                 const TT = td.getTargetType();
                 if (TT != pt.child) {
@@ -1079,11 +1215,18 @@ pub const TypeDataCollector = struct {
                 td.attrs.is_comptime_only = payload_attrs.is_comptime_only;
                 td.attrs.has_pointer = payload_attrs.has_pointer;
             },
-            .Pointer => |pt| {
-                const child_attrs = self.getAttributes(pt.child);
-                td.attrs.is_supported = child_attrs.is_supported;
-                td.attrs.is_comptime_only = child_attrs.is_comptime_only;
-                td.attrs.has_pointer = true;
+            .Pointer => |pt| switch (@typeInfo(pt.child)) {
+                .Fn => |f| {
+                    // function pointers can receive JS functions, which get called asynchronously
+                    td.attrs.is_callback = true;
+                    td.attrs.is_supported = self.isCallable(f);
+                },
+                else => {
+                    const child_attrs = self.getAttributes(pt.child);
+                    td.attrs.is_supported = child_attrs.is_supported;
+                    td.attrs.is_comptime_only = child_attrs.is_comptime_only;
+                    td.attrs.has_pointer = true;
+                },
             },
             inline .Array, .Optional => |ar| {
                 const child_attrs = self.getAttributes(ar.child);
@@ -1125,6 +1268,27 @@ pub const TypeDataCollector = struct {
         }
     }
 
+    fn isCallable(comptime self: *@This(), comptime f: std.builtin.Type.Fn) bool {
+        if (f.is_generic or f.is_var_args or f.return_type != void) {
+            return false;
+        }
+        if (f.params.len > max_callback_args) {
+            return false;
+        }
+        inline for (f.params) |param| {
+            // arguments are copied; pointers would not remain valid until the JS function runs
+            const PT = param.type orelse return false;
+            if (isHostProvided(PT)) {
+                return false;
+            }
+            const param_attrs = self.getAttributes(PT);
+            if (!param_attrs.is_supported or param_attrs.has_unsupported or param_attrs.is_comptime_only or param_attrs.has_pointer) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     fn getName(comptime self: *@This(), comptime T: type) [:0]const u8 {
         const td = self.get(T);
         self.setName(td);
@@ -1263,6 +1427,9 @@ test "TypeDataCollector.setAttributes" {
 
         pub var slice_of_slices: [][]u8 = undefined;
         pub var array_of_pointers: [5]*u8 = undefined;
+
+        pub const Callback = *const fn (i32, A) void;
+        pub const PointerCallback = *const fn ([]const u8) void;
     };
     comptime var tdc = TypeDataCollector.init(0);
     comptime tdc.scan(Test);
@@ -1282,6 +1449,10 @@ test "TypeDataCollector.setAttributes" {
     try expectCT(tdc.get(i18).isSupported() == true);
     // pointer should include this
     try expectCT(tdc.get(usize).isSupported() == true);
+    // callbacks cannot return values or receive pointers
+    try expectCT(tdc.get(Test.Callback).isSupported() == true);
+    try expectCT(tdc.get(Test.PointerCallback).isSupported() == false);
+    try expectCT(tdc.get(Test.Callback).getStructureType() == .function);
 
     // is_comptime_only
     try expectCT(tdc.get(type).isComptimeOnly() == true);
@@ -1300,6 +1471,10 @@ test "TypeDataCollector.setAttributes" {
     try expectCT(tdc.get(Test.D).hasPointer() == false);
     // // comptime fields should be ignored
     try expectCT(tdc.get(Test.E).hasPointer() == false);
+    try expectCT(tdc.get(Test.Callback).hasPointer() == false);
+    // is_callback
+    try expectCT(tdc.get(Test.Callback).isCallback() == true);
+    try expectCT(tdc.get([*]i32).isCallback() == false);
 }
 
 test "TypeDataCollector.setNames" {
@@ -1406,12 +1581,36 @@ test "Slice" {
     try expect(C != B);
 }
 
+// ThreadPool from zigar.zig is recognized by its marker, since it's compiled as part of a
+// different module
+pub fn isThreadPool(comptime T: type) bool {
+    return switch (@typeInfo(T)) {
+        .Struct => @hasDecl(T, "is_zigar_thread_pool"),
+        else => false,
+    };
+}
+
+// parameters provided by the host instead of the caller
+pub fn isHostProvided(comptime T: type) bool {
+    return T == std.mem.Allocator or isThreadPool(T);
+}
+
+test "isHostProvided" {
+    const ThreadPool = struct {
+        pub const is_zigar_thread_pool = true;
+    };
+    try expect(isHostProvided(std.mem.Allocator));
+    try expect(isHostProvided(ThreadPool));
+    try expect(!isHostProvided(i32));
+    try expect(!isHostProvided(struct {}));
+}
+
 pub fn ArgumentStruct(comptime T: type) type {
     const f = @typeInfo(T).Fn;
     const count = get: {
         var count = 1;
         for (f.params) |param| {
-            if (param.type != std.mem.Allocator and param.type != null) {
+            if (param.type != null and !isHostProvided(param.type.?)) {
                 count += 1;
             }
         }
@@ -1431,7 +1630,7 @@ pub fn ArgumentStruct(comptime T: type) type {
     };
     var arg_index = 0;
     for (f.params) |param| {
-        if (param.type != std.mem.Allocator and param.type != null) {
+        if (param.type != null and !isHostProvided(param.type.?)) {
             const name = std.fmt.comptimePrint("{d}", .{arg_index});
             fields[arg_index + 1] = .{
                 .name = name,
@@ -0,0 +1,77 @@
+const std = @import("std");
+
+// this file is made available to modules as @import("zigar")
+
+// Work-stealing thread pool shared by all modules loaded into the process. A function receives
+// it by declaring a parameter of this type, which, like std.mem.Allocator, is provided by the
+// host instead of JavaScript. The number of threads is set through setThreadCount() on the JS
+// side.
+pub const ThreadPool = struct {
+    ptr: *anyopaque,
+    vtable: *const VTable,
+
+    // checked by the exporter, since this type is not visible to it
+    pub const is_zigar_thread_pool = true;
+
+    pub const Task = extern struct {
+        run: *const fn (*Task) callconv(.C) void,
+        prev: ?*Task = null,
+        next: ?*Task = null,
+    };
+    pub const VTable = extern struct {
+        spawn: *const fn (*anyopaque, *Task) callconv(.C) bool,
+        run_pending: *const fn (*anyopaque) callconv(.C) bool,
+        get_thread_count: *const fn (*anyopaque) callconv(.C) usize,
+        // closures come from the pool's allocator, since page_allocator, the only one available
+        // without libc, would map a page for every task
+        allocate: *const fn (*anyopaque, usize, usize) callconv(.C) ?[*]u8,
+        free: *const fn (*anyopaque, [*]u8, usize, usize) callconv(.C) void,
+    };
+
+    // same interface as std.Thread.Pool.spawnWg()
+    pub fn spawnWg(self: ThreadPool, wait_group: *std.Thread.WaitGroup, comptime func: anytype, args: anytype) void {
+        wait_group.start();
+        const Args = @TypeOf(args);
+        const Closure = struct {
+            arguments: Args,
+            wait_group: *std.Thread.WaitGroup,
+            pool: ThreadPool,
+            task: Task = .{ .run = runFn },
+
+            fn runFn(task: *Task) callconv(.C) void {
+                const closure: *@This() = @alignCast(@fieldParentPtr("task", task));
+                @call(.auto, func, closure.arguments);
+                const wg = closure.wait_group;
+                const pool = closure.pool;
+                pool.vtable.free(pool.ptr, @ptrCast(closure), @sizeOf(@This()), @alignOf(@This()));
+                wg.finish();
+            }
+        };
+        const bytes = self.vtable.allocate(self.ptr, @sizeOf(Closure), @alignOf(Closure)) orelse {
+            // run it here when memory runs out
+            @call(.auto, func, args);
+            wait_group.finish();
+            return;
+        };
+        const closure: *Closure = @ptrCast(@alignCast(bytes));
+        closure.* = .{ .arguments = args, .wait_group = wait_group, .pool = self };
+        if (!self.vtable.spawn(self.ptr, &closure.task)) {
+            // pool is shutting down
+            Closure.runFn(&closure.task);
+        }
+    }
+
+    // help with pending tasks while waiting for the group to finish
+    pub fn waitAndWork(self: ThreadPool, wait_group: *std.Thread.WaitGroup) void {
+        while (!wait_group.isDone()) {
+            if (!self.vtable.run_pending(self.ptr)) {
+                wait_group.wait();
+                return;
+            }
+        }
+    }
+
+    pub fn getThreadCount(self: ThreadPool) usize {
+        return self.vtable.get_thread_count(self.ptr);
+    }
+};
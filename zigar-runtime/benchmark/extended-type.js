@@ -0,0 +1,79 @@
+import { getNumericAccessor, useAllExtendedTypes } from '../src/data-view.js';
+import { NodeEnvironment } from '../src/environment-node.js';
+import { useAllMemberTypes } from '../src/member.js';
+import { useAllStructureTypes } from '../src/structure.js';
+import { MemberType, StructureType } from '../src/types.js';
+import { bench, suite } from './harness.js';
+
+useAllMemberTypes();
+useAllStructureTypes();
+useAllExtendedTypes();
+
+const count = 1024;
+const types = [
+  { type: MemberType.Int, bitSize: 128, name: 'i128', value: -0x1234_5678_9ABC_DEF0_1234_5678n },
+  { type: MemberType.Uint, bitSize: 128, name: 'u128', value: 0xFEDC_BA98_7654_3210_FEDC_BA98_7654_3210n },
+  { type: MemberType.Float, bitSize: 80, name: 'f80', value: Math.PI },
+  { type: MemberType.Float, bitSize: 128, name: 'f128', value: -Math.E },
+];
+
+suite('Extended type accessors');
+for (const { type, bitSize, name, value } of types) {
+  const member = { type, bitSize, byteSize: 16, bitOffset: 0 };
+  const get = getNumericAccessor('get', member);
+  const set = getNumericAccessor('set', member);
+  const dv = new DataView(new ArrayBuffer(16 * count));
+  bench(`${name} write x ${count}`, () => {
+    for (let i = 0, offset = 0; i < count; i++, offset += 16) {
+      set.call(dv, offset, value, true);
+    }
+  });
+  bench(`${name} read x ${count}`, () => {
+    let sum;
+    for (let i = 0, offset = 0; i < count; i++, offset += 16) {
+      sum = get.call(dv, offset, true);
+    }
+    return sum;
+  });
+}
+
+suite('Bulk transfer of []u128');
+const env = new NodeEnvironment();
+const structure = env.beginStructure({
+  type: StructureType.Slice,
+  name: '[]u128',
+  byteSize: 16,
+});
+env.attachMember(structure, {
+  type: MemberType.Uint,
+  bitSize: 128,
+  byteSize: 16,
+  structure: { constructor: function() {} },
+});
+env.finalizeShape(structure);
+env.finalizeStructure(structure);
+const { constructor: U128Slice } = structure;
+const slice = new U128Slice(count);
+const words = new BigUint64Array(count * 2);
+for (let i = 0; i < words.length; i++) {
+  words[i] = BigInt(i) * 0x0101_0101n;
+}
+const values = [ ...slice.getRange(0, count) ];
+bench(`set() x ${count}`, () => {
+  for (let i = 0; i < count; i++) {
+    slice.set(i, values[i]);
+  }
+});
+bench(`setRange() with word pairs x ${count}`, () => {
+  slice.setRange(0, words);
+});
+bench(`get() x ${count}`, () => {
+  let value;
+  for (let i = 0; i < count; i++) {
+    value = slice.get(i);
+  }
+  return value;
+});
+bench(`getRange() into word pairs x ${count}`, () => {
+  slice.getRange(0, count, words);
+});
@@ -0,0 +1,35 @@
+import { performance } from 'perf_hooks';
+
+export function bench(name, cb, options = {}) {
+  const {
+    duration = 500,
+    warmup = 100,
+  } = options;
+  // let the JIT settle before measuring
+  const warmupEnd = performance.now() + warmup;
+  while (performance.now() < warmupEnd) {
+    cb();
+  }
+  let count = 0;
+  const start = performance.now();
+  const end = start + duration;
+  let now = start;
+  while (now < end) {
+    cb();
+    count++;
+    now = performance.now();
+  }
+  const opsPerSec = count / ((now - start) / 1000);
+  const result = { name, opsPerSec, count };
+  console.log(`${name.padEnd(48)} ${formatNumber(opsPerSec).padStart(16)} ops/sec`);
+  return result;
+}
+
+export function suite(title) {
+  console.log(`\n${title}`);
+  console.log('-'.repeat(title.length));
+}
+
+function formatNumber(n) {
+  return Math.round(n).toLocaleString('en-US');
+}
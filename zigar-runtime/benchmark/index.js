@@ -0,0 +1,3 @@
+import './extended-type.js';
+import './lazy-structures.js';
+import './packed-struct.js';
@@ -0,0 +1,115 @@
+import { performance } from 'perf_hooks';
+import { Environment } from '../src/environment.js';
+import { useAllMemberTypes } from '../src/member.js';
+import { useAllStructureTypes } from '../src/structure.js';
+import { MemberType, StructureType } from '../src/types.js';
+import { suite } from './harness.js';
+
+useAllMemberTypes();
+useAllStructureTypes();
+
+const typeCount = 2000;
+const fieldCount = 8;
+const methodCount = 4;
+
+function createStructure(type, name, byteSize, members = [], staticMembers = [], methods = []) {
+  return {
+    constructor: null,
+    typedArray: null,
+    type,
+    name,
+    byteSize,
+    align: 4,
+    isConst: false,
+    isTuple: false,
+    isIterator: false,
+    hasPointer: false,
+    instance: { members, methods: [], template: null },
+    static: { members: staticMembers, methods, template: null },
+  };
+}
+
+function createDefinition() {
+  // mimic a module exporting a large number of types, each with a few methods
+  const structures = [];
+  const i32 = createStructure(StructureType.Primitive, 'i32', 4, [
+    { type: MemberType.Int, bitOffset: 0, bitSize: 32, byteSize: 4 },
+  ]);
+  structures.push(i32);
+  const rootStaticMembers = [];
+  const rootSlots = {};
+  let thunkId = 1;
+  for (let i = 0; i < typeCount; i++) {
+    const fields = [];
+    for (let j = 0; j < fieldCount; j++) {
+      fields.push({
+        name: `field${j}`,
+        type: MemberType.Int,
+        bitOffset: j * 32,
+        bitSize: 32,
+        byteSize: 4,
+        structure: i32,
+      });
+    }
+    const methods = [];
+    for (let j = 0; j < methodCount; j++) {
+      const argStruct = createStructure(StructureType.ArgStruct, `method${j}`, 4, [
+        { name: 'retval', type: MemberType.Int, bitOffset: 0, bitSize: 32, byteSize: 4, structure: i32 },
+      ]);
+      structures.push(argStruct);
+      methods.push({ name: `method${j}`, argStruct, thunkId: thunkId++ });
+    }
+    const struct = createStructure(StructureType.Struct, `Type${i}`, fieldCount * 4, fields, [], methods);
+    structures.push(struct);
+    rootStaticMembers.push({ name: `Type${i}`, type: MemberType.Type, slot: i });
+    rootSlots[i] = { structure: struct };
+  }
+  const argStruct = createStructure(StructureType.ArgStruct, 'hello', 0, [
+    { name: 'retval', type: MemberType.Void, bitOffset: 0, bitSize: 0, byteSize: 0 },
+  ]);
+  structures.push(argStruct);
+  const root = createStructure(StructureType.Struct, 'root', 0, [], rootStaticMembers, [
+    { name: 'hello', argStruct, thunkId: 0 },
+  ]);
+  root.static.template = { slots: rootSlots };
+  structures.push(root);
+  return { structures, root };
+}
+
+function measure(label, lazyStructures, typeExports) {
+  globalThis.gc?.();
+  const heapBefore = process.memoryUsage().heapUsed;
+  const { structures, root } = createDefinition();
+  const start = performance.now();
+  const env = new Environment();
+  env.lazyStructures = lazyStructures;
+  env.invokeThunk = () => {};
+  env.recreateStructures(structures, {});
+  // what the generated module does on load: obtain the root namespace, then read its named
+  // exports, which include every type unless omitTypeExports is set
+  const { constructor } = root;
+  if (typeExports) {
+    for (let i = 0; i < typeCount; i++) {
+      constructor[`Type${i}`];
+    }
+  }
+  constructor.hello();
+  // use one of the types
+  const { Type0 } = constructor;
+  new Type0({});
+  const timeToFirstCall = performance.now() - start;
+  globalThis.gc?.();
+  const heapAfter = process.memoryUsage().heapUsed;
+  const heapUsed = (heapAfter - heapBefore) / 1024 / 1024;
+  console.log(`${label.padEnd(24)} time to first use: ${timeToFirstCall.toFixed(1).padStart(8)} ms   heap: ${heapUsed.toFixed(1).padStart(7)} MB`);
+  // keep everything alive until heap has been measured
+  return env && constructor;
+}
+
+suite(`Module load (${typeCount} types, ${methodCount} methods each)`);
+if (!globalThis.gc) {
+  console.log('(run with --expose-gc for accurate heap sizes)');
+}
+measure('eager', false, true);
+measure('lazy, types exported', true, true);
+measure('lazy, omitTypeExports', true, false);
@@ -0,0 +1,56 @@
+import { getNumericAccessor, useAllExtendedTypes } from '../src/data-view.js';
+import { MemberType } from '../src/types.js';
+import { bench, suite } from './harness.js';
+
+useAllExtendedTypes();
+
+const count = 1024;
+// packed struct {
+//   flags: u3, seq: u21, kind: u4, length: u12, ack: u33, checksum: i22, reserved: u33
+// }
+const byteSize = 16;
+const fields = [
+  { name: 'flags', type: MemberType.Uint, bitOffset: 0, bitSize: 3, value: 5 },
+  { name: 'seq', type: MemberType.Uint, bitOffset: 3, bitSize: 21, value: 0x12345 },
+  { name: 'kind', type: MemberType.Uint, bitOffset: 24, bitSize: 4, value: 9 },
+  { name: 'length', type: MemberType.Uint, bitOffset: 28, bitSize: 12, value: 1500 },
+  { name: 'ack', type: MemberType.Uint, bitOffset: 40, bitSize: 33, value: 0x1_2345_6789n },
+  { name: 'checksum', type: MemberType.Int, bitOffset: 73, bitSize: 22, value: -12345 },
+  { name: 'reserved', type: MemberType.Uint, bitOffset: 95, bitSize: 33, value: 0n },
+];
+const accessors = fields.map(({ type, bitOffset, bitSize, value }) => ({
+  get: getNumericAccessor('get', { type, bitOffset, bitSize }),
+  set: getNumericAccessor('set', { type, bitOffset, bitSize }),
+  offset: bitOffset >> 3,
+  value,
+}));
+const dv = new DataView(new ArrayBuffer(byteSize * count));
+
+// big-endian access goes through the bit-by-bit copy, giving a baseline for comparison
+for (const [ label, littleEndian ] of [ [ 'little-endian', true ], [ 'big-endian', false ] ]) {
+  suite(`Packed header (${label})`);
+  bench(`write all fields x ${count}`, () => {
+    for (let i = 0, base = 0; i < count; i++, base += byteSize) {
+      for (const { set, offset, value } of accessors) {
+        set.call(dv, base + offset, value, littleEndian);
+      }
+    }
+  });
+  bench(`read all fields x ${count}`, () => {
+    let last;
+    for (let i = 0, base = 0; i < count; i++, base += byteSize) {
+      for (const { get, offset } of accessors) {
+        last = get.call(dv, base + offset, littleEndian);
+      }
+    }
+    return last;
+  });
+  const { get: getSeq, offset: seqOffset } = accessors[1];
+  bench(`read seq x ${count}`, () => {
+    let sum = 0;
+    for (let i = 0, base = 0; i < count; i++, base += byteSize) {
+      sum += getSeq.call(dv, base + seqOffset, littleEndian);
+    }
+    return sum;
+  });
+}
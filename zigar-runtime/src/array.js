@@ -1,9 +1,11 @@
-import { getCompatibleTags, getTypedArrayClass } from './data-view.js';
-import { ArrayLengthMismatch, InvalidArrayInitializer, throwReadOnly } from './error.js';
-import { getDescriptor } from './member.js';
+import { getCompatibleTags, getTypedArrayClass, isTypedArray, setDataView } from './data-view.js';
+import {
+  ArrayLengthMismatch, InvalidArrayInitializer, OutOfBound, TypeMismatch, throwReadOnly
+} from './error.js';
+import { getDescriptor, isNumberMode } from './member.js';
 import { getDestructor, getMemoryCopier } from './memory.js';
 import {
-  attachDescriptors, createConstructor, createPropertyApplier, makeReadOnly
+  attachDescriptors, createConstructor, createPropertyApplier, getSelf, makeReadOnly
 } from './object.js';
 import { always, copyPointer, getProxy } from './pointer.js';
 import {
@@ -11,10 +13,11 @@ import {
   getTypedArrayDescriptor, getValueOf, handleError
 } from './special.js';
 import {
-  ALIGN, ARRAY, COMPAT, CONST_TARGET, COPIER, ELEMENT_GETTER, ELEMENT_SETTER, ENTRIES_GETTER,
-  MEMORY, PARENT, POINTER_VISITOR, PROXY, SIZE, SLOTS, TYPE, VIVIFICATOR, WRITE_DISABLER
+  ALIGN, ARRAY, COMPAT, CONST_TARGET, COPIER, ELEMENT_GETTER, ELEMENT_SETTER, ENTRIES_GETTER, FIXED,
+  MEMORY, PACKED, PARENT, POINTER_VISITOR, PROXY, SIZE, SLOTS, TYPE, VIVIFICATOR, WRITE_DISABLER
 } from './symbol.js';
-import { MemberType } from './types.js';
+import { encodeTextList } from './text.js';
+import { MemberType, StructureType, getIntRange } from './types.js';
 
 export function defineArray(structure, env) {
   const {
@@ -36,12 +39,19 @@ export function defineArray(structure, env) {
   const { get, set } = getDescriptor(member, env);
   const hasStringProp = canBeString(member);
   const propApplier = createPropertyApplier(structure);
+  const bulkCopier = getBulkCopier(structure, env);
+  const stringPacker = getStringPacker(structure, env);
+  const flatArray = getFlatArrayClass(structure);
   const initializer = function(arg) {
     if (arg instanceof constructor) {
       this[COPIER](arg);
       if (hasPointer) {
         this[POINTER_VISITOR](copyPointer, { vivificate: true, source: arg });
       }
+    } else if (isTypedArray(arg, flatArray)) {
+      // elements of all vectors in one typed array
+      const dv = new DataView(arg.buffer, arg.byteOffset, arg.byteLength);
+      setDataView.call(this, dv, structure, true, false, {});
     } else {
       if (typeof(arg) === 'string' && hasStringProp) {
         arg = { string: arg };
@@ -51,9 +61,11 @@ export function defineArray(structure, env) {
         if (arg.length !== length) {
           throw new ArrayLengthMismatch(structure, this, arg);
         }
-        let i = 0;
-        for (const value of arg) {
-          set.call(this, i++, value);
+        if (!bulkCopier?.(this, 0, arg) && !stringPacker?.(this, arg)) {
+          let i = 0;
+          for (const value of arg) {
+            set.call(this, i++, value);
+          }
         }
       } else if (arg && typeof(arg) === 'object') {
         if (propApplier.call(this, arg) === 0) {
@@ -64,19 +76,23 @@ export function defineArray(structure, env) {
       }
     }
   };
-  const finalizer = createArrayProxy;
+  const finalizer = (env.arrayProxy !== false) ? createArrayProxy : null;
   const constructor = structure.constructor = createConstructor(structure, { initializer, finalizer }, env);
   const typedArray = structure.typedArray = getTypedArrayClass(member);
   const hasObject = member.type === MemberType.Object;
+  const { getRange, setRange, fill } = getRangeFunctions(structure, env);
   const instanceDescriptors = {
-    $: { get: getProxy, set: initializer },
+    $: { get: (finalizer) ? getProxy : getSelf, set: initializer },
     length: { value: length },
     dataView: getDataViewDescriptor(structure),
     base64: getBase64Descriptor(structure),
-    string: hasStringProp && getStringDescriptor(structure),
+    string: hasStringProp && getStringDescriptor(structure, {}, env),
     typedArray: typedArray && getTypedArrayDescriptor(structure),
     get: { value: get },
     set: { value: set },
+    getRange: { value: getRange },
+    setRange: { value: setRange },
+    fill: { value: fill },
     entries: { value: getArrayEntries },
     valueOf: { value: getValueOf },
     toJSON: { value: convertToJSON },
@@ -108,6 +124,8 @@ export function createArrayProxy() {
 export function makeArrayReadOnly() {
   makeReadOnly.call(this);
   Object.defineProperty(this, 'set', { value: throwReadOnly });
+  Object.defineProperty(this, 'setRange', { value: throwReadOnly });
+  Object.defineProperty(this, 'fill', { value: throwReadOnly });
   const get = this.get;
   const getReadOnly = function(index) {
     const element = get.call(this, index);
@@ -123,6 +141,245 @@ export function canBeString(member) {
   return member.type === MemberType.Uint && [ 8, 16 ].includes(member.bitSize);
 }
 
+export function adjustIndex(index, len) {
+  index = index | 0;
+  if (index < 0) {
+    index = len + index;
+    if (index < 0) {
+      index = 0;
+    }
+  } else {
+    if (index > len) {
+      index = len;
+    }
+  }
+  return index;
+}
+
+export function getBulkArrayClass(structure, env) {
+  const {
+    littleEndian = true,
+  } = env;
+  const { instance: { members: [ member ] } } = structure;
+  const TypedArray = getTypedArrayClass(member);
+  if (!TypedArray || !littleEndian) {
+    return null;
+  }
+  // only plain numbers occupying all bits of their storage can be copied without conversion
+  const { type, bitSize, byteSize, structure: elementStructure } = member;
+  switch (type) {
+    case MemberType.Int:
+    case MemberType.Uint:
+    case MemberType.Float:
+      break;
+    default:
+      return null;
+  }
+  switch (elementStructure?.type) {
+    case StructureType.Enum:
+    case StructureType.ErrorSet:
+      return null;
+  }
+  return (bitSize === byteSize * 8) ? TypedArray : null;
+}
+
+export function getFlatArrayClass(structure) {
+  // arrays and slices of vectors can be initialized from a typed array holding the elements of
+  // every vector, provided that there's no padding between them
+  const { instance: { members: [ member ] } } = structure;
+  if (member.structure?.type !== StructureType.Vector) {
+    return null;
+  }
+  return getTypedArrayClass(member);
+}
+
+export function getWordPairArrayClass(structure, env) {
+  const {
+    littleEndian = true,
+  } = env;
+  const { instance: { members: [ member ] } } = structure;
+  const { type, bitSize, byteSize, structure: elementStructure } = member;
+  if (!littleEndian || bitSize !== 128 || byteSize !== 16) {
+    return null;
+  }
+  if (type !== MemberType.Int && type !== MemberType.Uint) {
+    return null;
+  }
+  switch (elementStructure?.type) {
+    case StructureType.Enum:
+    case StructureType.ErrorSet:
+      return null;
+  }
+  return BigUint64Array;
+}
+
+export function getBulkCopier(structure, env) {
+  const TypedArray = getBulkArrayClass(structure, env);
+  if (!TypedArray) {
+    return null;
+  }
+  const {
+    runtimeSafety = true,
+  } = env;
+  const { instance: { members: [ member ] } } = structure;
+  const acceptsNumbers = TypedArray !== BigInt64Array && TypedArray !== BigUint64Array;
+  const { min, max } = (runtimeSafety && member.type !== MemberType.Float) ? getIntRange(member) : {};
+  // copy a typed array or an array of numbers into the memory of the given array/slice;
+  // return false when the argument needs to go through the per-element setter
+  return function(self, index, arg) {
+    if (!isTypedArray(arg, TypedArray)) {
+      if (!acceptsNumbers || !Array.isArray(arg)) {
+        return false;
+      }
+      for (let i = 0, len = arg.length; i < len; i++) {
+        const value = arg[i];
+        if (typeof(value) !== 'number' || value < min || value > max) {
+          return false;
+        }
+      }
+    }
+    const dv = self.dataView;
+    const offset = dv.byteOffset + index * TypedArray.BYTES_PER_ELEMENT;
+    const dest = new TypedArray(dv.buffer, offset, arg.length);
+    dest.set(arg);
+    return true;
+  };
+}
+
+export function getStringPacker(structure, env) {
+  const { instance: { members: [ member ] } } = structure;
+  if (member.structure?.type !== StructureType.SlicePointer) {
+    return null;
+  }
+  const { instance: { members: [ { structure: targetStructure } ] } } = member.structure;
+  const { instance: { members: [ element, sentinel ] } } = targetStructure;
+  if (element.type !== MemberType.Uint || element.bitSize !== 8 || sentinel) {
+    return null;
+  }
+  // encode a list of strings given for [][]const u8 into a single buffer, with each pointer
+  // pointing to a part of it, so that it's passed to Zig as one memory region instead of one
+  // allocation per string; return false when the argument isn't such a list
+  return function(self, arg) {
+    if (!Array.isArray(arg)) {
+      return false;
+    }
+    for (let i = 0, len = arg.length; i < len; i++) {
+      if (typeof(arg[i]) !== 'string') {
+        return false;
+      }
+    }
+    const { array, ends } = encodeTextList(arg);
+    // strings go into fixed memory when the list itself is there
+    const fixed = !!self[MEMORY][FIXED];
+    const dv = env.allocateMemory(array.length, 1, fixed);
+    const { buffer, byteOffset } = dv;
+    new Uint8Array(buffer, byteOffset, array.length).set(array);
+    if (!fixed) {
+      buffer[PACKED] = true;
+    }
+    const Target = targetStructure.constructor;
+    for (let i = 0, start = 0, len = arg.length; i < len; i++) {
+      const end = ends[i];
+      self.set(i, Target(env.obtainView(buffer, byteOffset + start, end - start)));
+      start = end;
+    }
+    return true;
+  };
+}
+
+export function getRangeFunctions(structure, env) {
+  const { instance: { members: [ member ] }, hasPointer } = structure;
+  const { byteSize: elementSize } = member;
+  // 64-bit integers represented as numbers are converted one by one into a Float64Array
+  const numberMode = isNumberMode(member, env);
+  // 128-bit integers are copied as pairs of 64-bit words, the low word coming first
+  const TypedArray = (numberMode) ? null : getBulkArrayClass(structure, env) ?? getWordPairArrayClass(structure, env);
+  const wordCount = (TypedArray) ? elementSize / TypedArray.BYTES_PER_ELEMENT : 1;
+  const bulkCopier = getBulkCopier(structure, env);
+  const getRange = function(begin, end, out) {
+    const self = this[ARRAY] ?? this;
+    const len = self.length;
+    begin = (begin === undefined) ? 0 : adjustIndex(begin, len);
+    end = (end === undefined) ? len : adjustIndex(end, len);
+    const count = Math.max(end - begin, 0);
+    if (TypedArray) {
+      const dv = self.dataView;
+      const offset = dv.byteOffset + begin * elementSize;
+      const src = new TypedArray(dv.buffer, offset, count * wordCount);
+      if (out === undefined) {
+        return src.slice();
+      }
+      if (!isTypedArray(out, TypedArray)) {
+        throw new TypeMismatch(TypedArray.name, out);
+      }
+      out.set(src);
+      return out;
+    } else {
+      if (out === undefined) {
+        out = (numberMode) ? new Float64Array(count) : new Array(count);
+      }
+      for (let i = 0; i < count; i++) {
+        out[i] = self.get(begin + i);
+      }
+      return out;
+    }
+  };
+  const setRange = function(begin, arg) {
+    const self = this[ARRAY] ?? this;
+    const len = self.length;
+    begin = adjustIndex(begin, len);
+    if (wordCount > 1 && isTypedArray(arg, TypedArray)) {
+      const count = arg.length / wordCount;
+      if (!Number.isInteger(count)) {
+        throw new TypeMismatch(`${TypedArray.name} holding word pairs`, arg);
+      }
+      if (begin + count > len) {
+        throw new OutOfBound(member, begin + count - 1);
+      }
+      const dv = self.dataView;
+      const offset = dv.byteOffset + begin * elementSize;
+      const dest = new TypedArray(dv.buffer, offset, arg.length);
+      dest.set(arg);
+      return;
+    }
+    arg = transformIterable(arg);
+    if (begin + arg.length > len) {
+      throw new OutOfBound(member, begin + arg.length - 1);
+    }
+    if (!bulkCopier?.(self, begin, arg)) {
+      let i = begin;
+      for (const value of arg) {
+        self.set(i++, value);
+      }
+    }
+  };
+  const fill = function(value, begin, end) {
+    const self = this[ARRAY] ?? this;
+    const len = self.length;
+    begin = (begin === undefined) ? 0 : adjustIndex(begin, len);
+    end = (end === undefined) ? len : adjustIndex(end, len);
+    if (begin < end) {
+      // let the setter validate and convert the value
+      self.set(begin, value);
+      if (hasPointer || elementSize === 0) {
+        for (let i = begin + 1; i < end; i++) {
+          self.set(i, value);
+        }
+      } else {
+        // replicate the bytes of the first element, doubling the span with each copy
+        const dv = self.dataView;
+        const offset = dv.byteOffset + begin * elementSize;
+        const bytes = new Uint8Array(dv.buffer, offset, (end - begin) * elementSize);
+        for (let filled = elementSize; filled < bytes.length; filled *= 2) {
+          bytes.copyWithin(filled, 0, Math.min(filled, bytes.length - filled));
+        }
+      }
+    }
+    return this;
+  };
+  return { getRange, setRange, fill };
+}
+
 export function getArrayIterator() {
   const self = this[ARRAY] ?? this;
   const length = this.length;
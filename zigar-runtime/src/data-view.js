@@ -40,6 +40,49 @@ export function getNumericAccessor(access, member) {
   });
 }
 
+export function getNumberAccessor(access, member) {
+  const { type, bitSize, byteSize } = member;
+  if (byteSize === 8 && isByteAligned(member)) {
+    // compose the value from two 32-bit words so no bigint is created
+    const signed = (type === MemberType.Int);
+    const hiBits = bitSize - 32;
+    const signMask = 2 ** (hiBits - 1);
+    const valueMask = (signed) ? signMask - 1 : 2 ** hiBits - 1;
+    const getUint32 = DataView.prototype.getUint32;
+    const setUint32 = DataView.prototype.setUint32;
+    if (access === 'get') {
+      return function(offset, littleEndian) {
+        const lo = getUint32.call(this, offset + (littleEndian ? 0 : 4), littleEndian);
+        const w = getUint32.call(this, offset + (littleEndian ? 4 : 0), littleEndian);
+        const hi = (signed) ? (w & valueMask) - ((w & signMask) >>> 0) : (w & valueMask) >>> 0;
+        return hi * 0x1_0000_0000 + lo;
+      };
+    } else {
+      const set = getNumericAccessor('set', member);
+      return function(offset, value, littleEndian) {
+        if (!Number.isSafeInteger(value)) {
+          // let the regular setter handle bigint and conversion
+          return set.call(this, offset, value, littleEndian);
+        }
+        const hi = Math.floor(value / 0x1_0000_0000);
+        const lo = value - hi * 0x1_0000_0000;
+        const w = (signed) ? (hi & valueMask) | ((hi < 0) ? signMask : 0) : hi & valueMask;
+        setUint32.call(this, offset + (littleEndian ? 0 : 4), lo, littleEndian);
+        setUint32.call(this, offset + (littleEndian ? 4 : 0), w >>> 0, littleEndian);
+      };
+    }
+  } else {
+    const accessor = getNumericAccessor(access, member);
+    if (access === 'get') {
+      return function(offset, littleEndian) {
+        return Number(accessor.call(this, offset, littleEndian));
+      };
+    } else {
+      return accessor;
+    }
+  }
+}
+
 const factories = {};
 
 export function useExtendedBool() {
@@ -158,6 +201,15 @@ export function getDataView(structure, arg, env) {
   return dv;
 }
 
+export function isSharedBuffer(buffer) {
+  return buffer?.[Symbol.toStringTag] === 'SharedArrayBuffer';
+}
+
+export function getAddressable(dv) {
+  // Node-API cannot access a SharedArrayBuffer directly, only through a view of it
+  return (isSharedBuffer(dv.buffer)) ? dv : dv.buffer;
+}
+
 export function checkDataView(dv) {
   if (dv?.[Symbol.toStringTag] !== 'DataView') {
     throw new TypeMismatch('a DataView', dv);
@@ -247,7 +299,16 @@ export function getTypedArrayClass(member) {
       case 8: return Float64Array;
     }
   } else if (memberType === MemberType.Object) {
-    return member.structure.typedArray;
+    const { structure } = member;
+    const { typedArray } = structure;
+    if (typedArray && structure.type === StructureType.Vector) {
+      // vectors whose storage is padded (e.g. @Vector(3, f32)) don't form one contiguous run of
+      // elements when placed in an array
+      if (structure.length * typedArray.BYTES_PER_ELEMENT !== byteSize) {
+        return null;
+      }
+    }
+    return typedArray;
   }
   return null;
 }
@@ -354,6 +415,23 @@ function getAlignedIntAccessor(access, member) {
         set.call(this, offset, n, littleEndian);
       };
     }
+  } else if (bitSize === 128) {
+    // the sign comes along with the upper word, no masking needed
+    const getHi = DataView.prototype.getBigInt64;
+    const getLo = DataView.prototype.getBigUint64;
+    const setWord = DataView.prototype.setBigUint64;
+    if (access === 'get') {
+      return function(offset, littleEndian) {
+        const lo = getLo.call(this, offset + (littleEndian ? 0 : 8), littleEndian);
+        const hi = getHi.call(this, offset + (littleEndian ? 8 : 0), littleEndian);
+        return (hi << 64n) | lo;
+      };
+    } else {
+      return function(offset, value, littleEndian) {
+        setWord.call(this, offset + (littleEndian ? 0 : 8), value, littleEndian);
+        setWord.call(this, offset + (littleEndian ? 8 : 0), value >> 64n, littleEndian);
+      };
+    }
   } else {
     // larger than 64 bits
     const { get, set } = getBigIntDescriptor(bitSize);
@@ -392,6 +470,21 @@ function getAlignedUintAccessor(access, member) {
         set.call(this, offset, n, littleEndian);
       };
     }
+  } else if (bitSize === 128) {
+    const getWord = DataView.prototype.getBigUint64;
+    const setWord = DataView.prototype.setBigUint64;
+    if (access === 'get') {
+      return function(offset, littleEndian) {
+        const lo = getWord.call(this, offset + (littleEndian ? 0 : 8), littleEndian);
+        const hi = getWord.call(this, offset + (littleEndian ? 8 : 0), littleEndian);
+        return (hi << 64n) | lo;
+      };
+    } else {
+      return function(offset, value, littleEndian) {
+        setWord.call(this, offset + (littleEndian ? 0 : 8), value, littleEndian);
+        setWord.call(this, offset + (littleEndian ? 8 : 0), value >> 64n, littleEndian);
+      };
+    }
   } else {
     // larger than 64 bits
     const { get, set } = getBigIntDescriptor(bitSize);
@@ -435,7 +528,7 @@ function getUnalignedIntAccessor(access, member) {
       };
     }
   }
-  return getUnalignedNumericAccessor(access, member);
+  return getBitFieldAccessor(access, member) ?? getUnalignedNumericAccessor(access, member);
 }
 
 function getUnalignedUintAccessor(access, member) {
@@ -460,7 +553,76 @@ function getUnalignedUintAccessor(access, member) {
       };
     }
   }
-  return getUnalignedNumericAccessor(access, member);
+  return getBitFieldAccessor(access, member) ?? getUnalignedNumericAccessor(access, member);
+}
+
+function getBitFieldAccessor(access, member) {
+  // mask and shift over a single 16, 32, or 64-bit load when the field fits in a word starting at
+  // its first byte; bits are numbered as in a little-endian bit stream, same as the bit-copying
+  // accessor, which is still used for big-endian data and for words that would run past the end
+  // of the view
+  const { type, bitSize, bitOffset } = member;
+  const bitPos = bitOffset & 0x07;
+  const wordSize = [ 16, 32, 64 ].find(s => s >= bitPos + bitSize);
+  if (!wordSize) {
+    return;
+  }
+  const wordBytes = wordSize / 8;
+  const signed = (type === MemberType.Int);
+  const fallback = getUnalignedNumericAccessor(access, member);
+  if (wordSize <= 32) {
+    const get = (wordSize === 16) ? DataView.prototype.getUint16 : DataView.prototype.getUint32;
+    // the field is never wider than 31 bits here, so bitwise operators can be used
+    const valueMask = 2 ** bitSize - 1;
+    const signMask = 2 ** (bitSize - 1);
+    const lowMask = signMask - 1;
+    if (access === 'get') {
+      return function(offset, littleEndian) {
+        if (!littleEndian || offset + wordBytes > this.byteLength) {
+          return fallback.call(this, offset, littleEndian);
+        }
+        const s = get.call(this, offset, true) >>> bitPos;
+        return (signed) ? (s & lowMask) - (s & signMask) : s & valueMask;
+      };
+    } else {
+      const set = (wordSize === 16) ? DataView.prototype.setUint16 : DataView.prototype.setUint32;
+      const outsideMask = ~(valueMask << bitPos);
+      return function(offset, value, littleEndian) {
+        if (!littleEndian || offset + wordBytes > this.byteLength) {
+          return fallback.call(this, offset, value, littleEndian);
+        }
+        const n = get.call(this, offset, true);
+        set.call(this, offset, (n & outsideMask) | ((value & valueMask) << bitPos), true);
+      };
+    }
+  } else {
+    const get = DataView.prototype.getBigUint64;
+    const shift = BigInt(bitPos);
+    const valueMask = (1n << BigInt(bitSize)) - 1n;
+    const outsideMask = 0xFFFF_FFFF_FFFF_FFFFn ^ (valueMask << shift);
+    if (access === 'get') {
+      // fields of 32 bits or fewer are still numbers even when they straddle a 32-bit word
+      const toNumber = (bitSize <= 32);
+      return function(offset, littleEndian) {
+        if (!littleEndian || offset + wordBytes > this.byteLength) {
+          return fallback.call(this, offset, littleEndian);
+        }
+        const w = get.call(this, offset, true) >> shift;
+        const n = (signed) ? BigInt.asIntN(bitSize, w) : BigInt.asUintN(bitSize, w);
+        return (toNumber) ? Number(n) : n;
+      };
+    } else {
+      const set = DataView.prototype.setBigUint64;
+      return function(offset, value, littleEndian) {
+        if (!littleEndian || offset + wordBytes > this.byteLength) {
+          return fallback.call(this, offset, value, littleEndian);
+        }
+        const w = get.call(this, offset, true);
+        const n = BigInt.asUintN(bitSize, BigInt(value));
+        set.call(this, offset, (w & outsideMask) | (n << shift), true);
+      };
+    }
+  }
 }
 
 function getAlignedFloatAccessor(access, member) {
@@ -510,124 +672,146 @@ function getAlignedFloatAccessor(access, member) {
       }
     }
   } else if (bitSize === 80) {
-    const buf = new DataView(new ArrayBuffer(8));
-    const get = function(offset, littleEndian) {
-      const w1 = BigInt(this.getUint32(offset + (littleEndian ? 0 : byteSize - 4), littleEndian));
-      const w2 = BigInt(this.getUint32(offset + (littleEndian ? 4 : byteSize - 8), littleEndian));
-      const w3 = BigInt(this.getUint32(offset + (littleEndian ? 8 : byteSize - 12), littleEndian));
-      return w1 | w2 << 32n | w3 << 64n;
-    };
-    const set = function(offset, value, littleEndian) {
-      const w1 = value & 0xFFFFFFFFn;
-      const w2 = (value >> 32n) & 0xFFFFFFFFn;
-      const w3 = (value >> 64n) & 0xFFFFFFFFn;
-      this.setUint32(offset + (littleEndian ? 0 : byteSize - 4), Number(w1), littleEndian);
-      this.setUint32(offset + (littleEndian ? 4 : byteSize - 8), Number(w2), littleEndian);
-      this.setUint32(offset + (littleEndian ? 8 : byteSize - 12), Number(w3), littleEndian);
-    };
+    // work with 32-bit words so no bigint is needed when converting to and from f64
+    const { getWord, setWord } = getWordAccessors(byteSize);
     if (access === 'get') {
       return function(offset, littleEndian) {
-        const n = get.call(this, offset, littleEndian);
-        const sign = n >> 79n;
-        const exp = (n & 0x7FFF0000000000000000n) >> 64n;
-        const frac = n & 0x00007FFFFFFFFFFFFFFFn;
-        if (exp === 0n) {
+        const m0 = getWord.call(this, offset, 0, littleEndian);
+        const m1 = getWord.call(this, offset, 1, littleEndian);
+        const top = getWord.call(this, offset, 2, littleEndian);
+        const sign = (top >>> 15) & 1;
+        const exp = top & 0x7FFF;
+        // fraction excludes the explicit integer bit (bit 63)
+        const fracHi = m1 & 0x7FFFFFFF;
+        if (exp === 0) {
           return (sign) ? -0 : 0;
-        } else if (exp === 0x7FFFn) {
-          if (!frac) {
+        } else if (exp === 0x7FFF) {
+          if (!fracHi && !m0) {
             return (sign) ? -Infinity : Infinity;
           } else {
             return NaN;
           }
         }
-        const exp64 = exp - 16383n + 1023n;
-        if (exp64 >= 2047n) {
+        const exp64 = exp - 16383 + 1023;
+        if (exp64 >= 2047) {
           return (sign) ? -Infinity : Infinity;
         }
-        const n64 = (sign << 63n) | (exp64 << 52n) | (frac >> 11n) + BigInt((frac & (2n**11n - 1n)) >= 2n**10n);
-        buf.setBigUint64(0, n64, littleEndian);
-        return buf.getFloat64(0, littleEndian);
-      }
+        const hi = (sign << 31 | exp64 << 20 | fracHi >>> 11) >>> 0;
+        const lo = ((fracHi & 0x7FF) << 21 | m0 >>> 11) >>> 0;
+        return composeFloat64(hi, lo, m0 & 0x400);
+      };
     } else {
       return function(offset, value, littleEndian) {
-        buf.setFloat64(0, value, littleEndian);
-        const n = buf.getBigUint64(0, littleEndian);
-        const sign = n >> 63n;
-        const exp = (n & 0x7FF0000000000000n) >> 52n;
-        const frac = n & 0x000FFFFFFFFFFFFFn;
-        let n80;
-        if (exp === 0n) {
-          n80 = sign << 79n | (frac << 11n);
-        } else if (exp === 0x07FFn) {
-          n80 = sign << 79n | 0x7FFFn << 64n | (frac ? 0x00002000000000000000n : 0n) | 0x00008000000000000000n;
-          //                                                 ^ bit 61                       ^ bit 63
+        float64Buffer.setFloat64(0, value);
+        const hi = float64Buffer.getUint32(0);
+        const lo = float64Buffer.getUint32(4);
+        const sign = hi >>> 31;
+        const exp = (hi >>> 20) & 0x7FF;
+        const fracHi = hi & 0x000FFFFF;
+        let top, m1, m0;
+        if (exp === 0) {
+          top = sign << 15;
+          m1 = fracHi << 11 | lo >>> 21;
+          m0 = lo << 11;
+        } else if (exp === 0x07FF) {
+          top = sign << 15 | 0x7FFF;
+          m1 = 0x80000000 | ((fracHi || lo) ? 0x20000000 : 0);
+          //   ^ bit 63                       ^ bit 61
+          m0 = 0;
         } else {
-          n80 = sign << 79n | (exp - 1023n + 16383n) << 64n | (frac << 11n) | 0x00008000000000000000n;
+          top = sign << 15 | (exp - 1023 + 16383);
+          m1 = 0x80000000 | fracHi << 11 | lo >>> 21;
+          m0 = lo << 11;
         }
-        set.call(this, offset, n80, littleEndian);
-      }
+        setWord.call(this, offset, 0, m0 >>> 0, littleEndian);
+        setWord.call(this, offset, 1, m1 >>> 0, littleEndian);
+        setWord.call(this, offset, 2, top, littleEndian);
+      };
     }
   } else if (bitSize === 128) {
-    const buf = new DataView(new ArrayBuffer(8));
-    const get = function(offset, littleEndian) {
-      const w1 = BigInt(this.getUint32(offset + (littleEndian ? 0 : byteSize - 4), littleEndian));
-      const w2 = BigInt(this.getUint32(offset + (littleEndian ? 4 : byteSize - 8), littleEndian));
-      const w3 = BigInt(this.getUint32(offset + (littleEndian ? 8 : byteSize - 12), littleEndian));
-      const w4 = BigInt(this.getUint32(offset + (littleEndian ? 12 : byteSize - 16), littleEndian));
-      return w1 | w2 << 32n | w3 << 64n | w4 << 96n;
-    };
-    const set = function(offset, value, littleEndian) {
-      const w1 = value & 0xFFFFFFFFn;
-      const w2 = (value >> 32n) & 0xFFFFFFFFn;
-      const w3 = (value >> 64n) & 0xFFFFFFFFn;
-      const w4 = (value >> 96n) & 0xFFFFFFFFn;
-      this.setUint32(offset + (littleEndian ? 0 : byteSize - 4), Number(w1), littleEndian);
-      this.setUint32(offset + (littleEndian ? 4 : byteSize - 8), Number(w2), littleEndian);
-      this.setUint32(offset + (littleEndian ? 8 : byteSize - 12), Number(w3), littleEndian);
-      this.setUint32(offset + (littleEndian ? 12 : byteSize - 16), Number(w4), littleEndian);
-    };
+    const { getWord, setWord } = getWordAccessors(byteSize);
     if (access === 'get') {
       return function(offset, littleEndian) {
-        const n = get.call(this, offset, littleEndian);
-        const sign = n >> 127n;
-        const exp = (n & 0x7FFF0000000000000000000000000000n) >> 112n;
-        const frac = n & 0x0000FFFFFFFFFFFFFFFFFFFFFFFFFFFFn;
-        if (exp === 0n) {
+        const w1 = getWord.call(this, offset, 1, littleEndian);
+        const w2 = getWord.call(this, offset, 2, littleEndian);
+        const w3 = getWord.call(this, offset, 3, littleEndian);
+        const sign = w3 >>> 31;
+        const exp = (w3 >>> 16) & 0x7FFF;
+        if (exp === 0) {
           return (sign) ? -0 : 0;
-        } else if (exp === 0x7FFFn) {
-          if (!frac) {
+        } else if (exp === 0x7FFF) {
+          const w0 = getWord.call(this, offset, 0, littleEndian);
+          if (!(w3 & 0xFFFF) && !w2 && !w1 && !w0) {
             return (sign) ? -Infinity : Infinity;
           } else {
             return NaN;
           }
         }
-        const exp64 = exp - 16383n + 1023n;
-        if (exp64 >= 2047n) {
+        const exp64 = exp - 16383 + 1023;
+        if (exp64 >= 2047) {
           return (sign) ? -Infinity : Infinity;
         }
-        const n64 = (sign << 63n) | (exp64 << 52n) | (frac >> 60n) + BigInt((frac & (2n**60n - 1n)) >= 2n**59n);
-        buf.setBigUint64(0, n64, littleEndian);
-        return buf.getFloat64(0, littleEndian);
-      }
+        // top 52 bits of the 112-bit fraction
+        const hi = (sign << 31 | exp64 << 20 | (w3 & 0xFFFF) << 4 | w2 >>> 28) >>> 0;
+        const lo = ((w2 & 0x0FFFFFFF) << 4 | w1 >>> 28) >>> 0;
+        return composeFloat64(hi, lo, w1 & 0x08000000);
+      };
     } else {
       return function(offset, value, littleEndian) {
-        buf.setFloat64(0, value, littleEndian);
-        const n = buf.getBigUint64(0, littleEndian);
-        const sign = n >> 63n;
-        const exp = (n & 0x7FF0000000000000n) >> 52n;
-        const frac = n & 0x000FFFFFFFFFFFFFn;
-        let n128;
-        if (exp === 0n) {
-          n128 = sign << 127n | (frac << 60n);
-        } else if (exp === 0x07FFn) {
-          n128 = sign << 127n | 0x7FFFn << 112n | (frac ? 1n : 0n);
+        float64Buffer.setFloat64(0, value);
+        const hi = float64Buffer.getUint32(0);
+        const lo = float64Buffer.getUint32(4);
+        const sign = hi >>> 31;
+        const exp = (hi >>> 20) & 0x7FF;
+        const fracHi = hi & 0x000FFFFF;
+        let w3, w2, w1, w0 = 0;
+        if (exp === 0x07FF) {
+          w3 = sign << 31 | 0x7FFF << 16;
+          w2 = w1 = 0;
+          w0 = (fracHi || lo) ? 1 : 0;
         } else {
-          n128 = sign << 127n | (exp - 1023n + 16383n) << 112n | (frac << 60n);
+          const exp128 = (exp === 0) ? 0 : exp - 1023 + 16383;
+          w3 = sign << 31 | exp128 << 16 | fracHi >>> 4;
+          w2 = (fracHi & 0xF) << 28 | lo >>> 4;
+          w1 = (lo & 0xF) << 28;
         }
-        set.call(this, offset, n128, littleEndian);
-      }
+        setWord.call(this, offset, 0, w0, littleEndian);
+        setWord.call(this, offset, 1, w1 >>> 0, littleEndian);
+        setWord.call(this, offset, 2, w2 >>> 0, littleEndian);
+        setWord.call(this, offset, 3, w3 >>> 0, littleEndian);
+      };
+    }
+  }
+}
+
+function getWordAccessors(byteSize) {
+  // access 32-bit words by significance, the least significant one being word 0
+  const getUint32 = DataView.prototype.getUint32;
+  const setUint32 = DataView.prototype.setUint32;
+  return {
+    getWord: function(offset, index, littleEndian) {
+      return getUint32.call(this, offset + (littleEndian ? index * 4 : byteSize - (index + 1) * 4), littleEndian);
+    },
+    setWord: function(offset, index, value, littleEndian) {
+      setUint32.call(this, offset + (littleEndian ? index * 4 : byteSize - (index + 1) * 4), value, littleEndian);
+    },
+  };
+}
+
+const float64Buffer = new DataView(new ArrayBuffer(8));
+
+function composeFloat64(hi, lo, roundUp) {
+  if (roundUp) {
+    // carry into the exponent is intended, it rounds the largest fraction up to the next power of 2
+    lo = lo + 1;
+    if (lo > 0xFFFFFFFF) {
+      lo = 0;
+      hi = hi + 1;
     }
   }
+  float64Buffer.setUint32(0, hi);
+  float64Buffer.setUint32(4, lo);
+  return float64Buffer.getFloat64(0);
 }
 
 function getUnalignedFloatAccessor(access, member) {
@@ -0,0 +1,38 @@
+// compiled at runtime by bun:ffi's cc() (TinyCC); declarations are given here instead of coming
+// from system headers so that nothing beyond libc is needed
+typedef __SIZE_TYPE__ size_t;
+
+void* malloc(size_t size);
+void free(void* ptr);
+void* memcpy(void* dest, const void* src, size_t len);
+
+typedef void (*deliver_function)(void*, void*, size_t);
+
+static deliver_function deliver = 0;
+
+void set_deliver(deliver_function fn) {
+    deliver = fn;
+}
+
+// this can be called from any thread--the arguments live on the caller's stack, so they're
+// copied before the call is handed to the thread-safe JSCallback, which frees the copy
+unsigned int queue_callback(void* handle,
+                            const void* bytes,
+                            size_t len) {
+    void* copy = malloc(len ? len : 1);
+    if (!copy || !deliver) {
+        free(copy);
+        return 1;
+    }
+    memcpy(copy, bytes, len);
+    deliver(handle, copy, len);
+    return 0;
+}
+
+void* get_queue_callback(void) {
+    return (void*) queue_callback;
+}
+
+void free_copy(void* copy) {
+    free(copy);
+}
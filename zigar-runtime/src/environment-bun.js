@@ -0,0 +1,596 @@
+import { CFunction, CString, JSCallback, cc, dlopen, ptr, read, toArrayBuffer } from 'bun:ffi';
+import { fileURLToPath } from 'url';
+import { NodeEnvironment } from './environment-node.js';
+import { Unsupported } from './error.js';
+import { decodeText, encodeText } from './text.js';
+
+// Environment that talks to the shared library through bun:ffi instead of the Node-API addon.
+// It performs the same work as addon.c, with C structs being read and written directly and
+// napi_value replaced by indices into a table of JavaScript values (as is done for WASM).
+// Only 64-bit platforms are supported, as that's all Bun runs on.
+
+const OK = 0;
+const FAILURE = 1;
+const MISSING_USIZE = 0xffff_ffff_ffff_ffffn;
+const MISSING_U16 = 0xffff;
+const MODULE_VERSION = 6;
+// the smallest page size (4K), so that scans never cross into the next page
+const scanChunkSize = 4096;
+
+// environments that are calling into Zig, keyed by the id passed as the call context
+const contexts = new Map();
+let nextContextId = 1;
+
+export class BunEnvironment extends NodeEnvironment {
+  wordSize = 8;
+  contextId = nextContextId++;
+  callDepth = 0;
+  nextValueIndex = 1;
+  valueTable = { 0: null };
+  valueIndices = new Map;
+  baseAddress = 0;
+  zig = null;
+  loadProfile = null;
+  // scratch space for out-parameters of calls into Zig
+  scratch = new BigUint64Array(4);
+  scratchAddress = ptr(this.scratch);
+
+  loadModule(path, options = {}) {
+    const { lazyBinding = false, profile = false } = options;
+    const loader = getLoader();
+    // console output isn't redirected, as Bun's stdout is the process's; the ioRedirect option
+    // therefore has no effect here
+    let time = performance.now();
+    const handle = loader.open(path, lazyBinding);
+    const dlopenTime = performance.now() - time;
+    if (!handle) {
+      throw new Error('Unable to load shared library');
+    }
+    time = performance.now();
+    const mod = loader.find(handle, 'zig_module');
+    const dlsymTime = performance.now() - time;
+    if (!mod) {
+      throw new Error('Unable to find the symbol "zig_module"');
+    }
+    if (read.u32(mod, 0) !== MODULE_VERSION) {
+      throw new Error('Cached module is compiled for a different version of Zigar');
+    }
+    time = performance.now();
+    const base = loader.getBase(handle, mod);
+    const dladdrTime = performance.now() - time;
+    if (!base) {
+      throw new Error('Unable to obtain address of shared library');
+    }
+    this.baseAddress = base;
+    time = performance.now();
+    this.zig = importFunctions(read.ptr(mod, 16));
+    exportFunctions(read.ptr(mod, 8));
+    const attributes = read.u32(mod, 4);
+    this.littleEndian = !!(attributes & 1);
+    this.runtimeSafety = !!(attributes & 2);
+    const patchTime = performance.now() - time;
+    if (profile) {
+      this.loadProfile = { dlopen: dlopenTime, dlsym: dlsymTime, dladdr: dladdrTime, patch: patchTime };
+    }
+  }
+
+  getLoadProfile() {
+    return this.loadProfile;
+  }
+
+  getBufferAddress(buffer) {
+    // unlike Node-API, bun:ffi has no trouble with SharedArrayBuffer
+    const ab = (buffer instanceof DataView) ? buffer.buffer : buffer;
+    return (ab.byteLength > 0) ? BigInt(ptr(ab)) : 0n;
+  }
+
+  allocateExternMemory(type, len, align) {
+    if (this.zig.allocateExternMemory(type, len, align, this.scratchAddress) !== OK) {
+      throw new Error('Unable to allocate fixed memory');
+    }
+    return this.scratch[0];
+  }
+
+  freeExternMemory(type, address, len, align) {
+    const mem = this.scratch;
+    mem[0] = BigInt(address);
+    mem[1] = BigInt(len);
+    mem[2] = BigInt(align);
+    this.zig.freeExternMemory(type, this.scratchAddress);
+  }
+
+  obtainExternBuffer(address, len) {
+    // need to include at least one byte; the library is never unloaded, so there's no need to
+    // keep a reference to it
+    return toArrayBuffer(Number(address), 0, len || 1);
+  }
+
+  copyBytes(dest, address, len) {
+    if (dest.byteLength !== len) {
+      throw new Error('Length mismatch');
+    }
+    if (len > 0) {
+      const src = new Uint8Array(toArrayBuffer(Number(address), 0, len));
+      new Uint8Array(dest.buffer, dest.byteOffset, len).set(src);
+    }
+  }
+
+  findSentinel(address, bytes) {
+    const len = bytes.byteLength;
+    if (address && len > 0) {
+      const start = Number(address);
+      const sentinel = new Uint8Array(bytes.buffer, bytes.byteOffset, len);
+      // memory is scanned a chunk at a time; a chunk never extends past the end of a page, since
+      // the page after the one holding the sentinel might not be mapped
+      let chunk = null, chunkStart = 0, chunkEnd = 0;
+      const nextChunk = (offset) => {
+        chunkStart = offset;
+        chunkEnd = offset + scanChunkSize - (start + offset) % scanChunkSize;
+        chunk = new Uint8Array(toArrayBuffer(start, chunkStart, chunkEnd - chunkStart));
+      };
+      if (len === 1) {
+        for (let offset = 0; offset < 0x7fff_ffff; offset = chunkEnd) {
+          nextChunk(offset);
+          const index = chunk.indexOf(sentinel[0]);
+          if (index !== -1) {
+            return chunkStart + index;
+          }
+        }
+      } else {
+        for (let i = 0, j = 0; i < 0x7fff_ffff; i += len, j++) {
+          let k = 0;
+          for (; k < len; k++) {
+            if (i + k >= chunkEnd) {
+              nextChunk(i + k);
+            }
+            if (chunk[i + k - chunkStart] !== sentinel[k]) {
+              break;
+            }
+          }
+          if (k === len) {
+            return j;
+          }
+        }
+      }
+    }
+  }
+
+  createString(address, len, charSize) {
+    // decode directly from Zig memory
+    if (len === 0) {
+      return '';
+    }
+    const ab = toArrayBuffer(Number(address), 0, len * charSize);
+    return (charSize === 2)
+    ? decodeText(new Uint8Array(ab), 'utf-16le')
+    : decodeText(new Uint8Array(ab));
+  }
+
+  encodeString(str, charSize) {
+    if (typeof(str) !== 'string') {
+      throw new TypeError('Argument must be string');
+    }
+    // leave room for a terminating zero, like the addon does
+    const ta = encodeText(str, (charSize === 2) ? 'utf-16' : 'utf-8');
+    const copy = new ta.constructor(ta.length + 1);
+    copy.set(ta);
+    return new DataView(copy.buffer, 0, ta.byteLength);
+  }
+
+  getFactoryThunk() {
+    if (this.zig.getFactoryThunk(this.scratchAddress) !== OK) {
+      throw new Error('Unable to define structures');
+    }
+    return Number(this.scratch[0]) - this.baseAddress;
+  }
+
+  runThunk(thunkId, dv) {
+    this.enterCall();
+    try {
+      const { contextId, baseAddress, scratch, scratchAddress } = this;
+      // pointer might not be valid when length is zero
+      const argAddress = (dv.byteLength > 0) ? ptr(dv) : null;
+      if (this.zig.runThunk(contextId, baseAddress + thunkId, argAddress, scratchAddress) !== OK) {
+        throw new Error('Unable to execute function');
+      }
+      return this.valueTable[Number(scratch[0])];
+    } finally {
+      this.leaveCall();
+    }
+  }
+
+  runVariadicThunk(thunkId, dv, attrDV) {
+    this.enterCall();
+    try {
+      const { contextId, baseAddress, scratch, scratchAddress } = this;
+      const argAddress = (dv.byteLength > 0) ? ptr(dv) : null;
+      const argCount = attrDV.byteLength / 8;
+      if (this.zig.runVariadicThunk(contextId, baseAddress + thunkId, argAddress, ptr(attrDV), argCount, scratchAddress) !== OK) {
+        throw new Error('Unable to execute function');
+      }
+      return this.valueTable[Number(scratch[0])];
+    } finally {
+      this.leaveCall();
+    }
+  }
+
+  getMemoryOffset(address) {
+    const base = BigInt(this.baseAddress);
+    // this happens when we encounter a regular ArrayBuffer with byteLength = 0
+    return (address < base) ? 0 : Number(BigInt(address) - base);
+  }
+
+  recreateAddress(reloc) {
+    return BigInt(this.baseAddress + reloc);
+  }
+
+  createJsCallback(fn) {
+    if (typeof(fn) !== 'function') {
+      throw new TypeError('Argument must be a function');
+    }
+    const handle = nextCallbackHandle++;
+    jsCallbacks.set(handle, fn);
+    if (!keepAlive) {
+      // a bound function keeps the event loop alive until it is released, as it does in Node
+      keepAlive = setInterval(() => {}, 0x7fff_ffff);
+    }
+    return BigInt(handle);
+  }
+
+  releaseJsCallback(handle) {
+    // unlike the Node-API version, calls still in transit when the function is released are
+    // dropped
+    jsCallbacks.delete(Number(handle));
+    if (jsCallbacks.size === 0 && keepAlive) {
+      clearInterval(keepAlive);
+      keepAlive = null;
+    }
+  }
+
+  setThreadCount(count) {
+    if (threadPool.ptr && (count === 0 || Number(threadPool.getThreadCount(threadPool.ptr)) !== count)) {
+      const { pending, active } = this.getThreadPoolStats();
+      if (pending > 0 || active > 0) {
+        throw new Error('Thread pool cannot be resized while it is busy');
+      }
+      // pool will get recreated with the new size when it's needed again
+      retireThreadPool();
+    }
+    threadPool.size = count;
+  }
+
+  getThreadPoolStats() {
+    if (!threadPool.ptr) {
+      return null;
+    }
+    const stats = new BigUint64Array(7);
+    threadPool.getStats(threadPool.ptr, ptr(stats));
+    const [ threads, submitted, completed, stolen, pending, sleeps, active ] = [ ...stats ].map(Number);
+    return { threads, submitted, completed, stolen, pending, sleeps, active };
+  }
+
+  mapFile(path, writable, access) {
+    // pages are shared with the file only when changes are meant to be written back
+    const array = Bun.mmap(path, { shared: writable });
+    return array.buffer;
+  }
+
+  unmapFile(buffer) {
+    // Bun doesn't provide a way to unmap a file; the mapping only goes away when the buffer is
+    // garbage-collected
+    throw new Unsupported();
+  }
+
+  adviseMemory(buffer, offset, len, access) {
+    // hints are not supported
+  }
+
+  enterCall() {
+    if (this.callDepth++ === 0) {
+      contexts.set(this.contextId, this);
+    }
+  }
+
+  leaveCall() {
+    if (--this.callDepth === 0) {
+      // values handed to Zig are only valid for the duration of the outermost call, like
+      // napi_value in the handle scope of a Node-API callback
+      contexts.delete(this.contextId);
+      this.clearExchangeTable();
+    }
+  }
+
+  clearExchangeTable() {
+    if (this.nextValueIndex !== 1) {
+      this.nextValueIndex = 1;
+      this.valueTable = { 0: null };
+      this.valueIndices = new Map();
+    }
+  }
+
+  getObjectIndex(object) {
+    if (object) {
+      let index = this.valueIndices.get(object);
+      if (index === undefined) {
+        index = this.nextValueIndex++;
+        this.valueIndices.set(object, index);
+        this.valueTable[index] = object;
+      }
+      return index;
+    } else {
+      return 0;
+    }
+  }
+
+  getObject(index) {
+    // bun:ffi gives null for zero pointers
+    return this.valueTable[index ?? 0] ?? null;
+  }
+}
+
+let loader = null;
+
+function getLoader() {
+  if (!loader) {
+    const cstr = (s) => Buffer.from(s + '\0');
+    if (process.platform === 'win32') {
+      const { symbols: { LoadLibraryA, GetProcAddress } } = dlopen('kernel32.dll', {
+        LoadLibraryA: { args: [ 'ptr' ], returns: 'ptr' },
+        GetProcAddress: { args: [ 'ptr', 'ptr' ], returns: 'ptr' },
+      });
+      loader = {
+        open: (path) => LoadLibraryA(cstr(path)),
+        find: (handle, name) => GetProcAddress(handle, cstr(name)),
+        // a module handle is the DLL's base address
+        getBase: (handle) => handle,
+      };
+    } else {
+      const lib = (process.platform === 'darwin') ? 'libSystem.B.dylib' : 'libdl.so.2';
+      const { symbols } = dlopen(lib, {
+        dlopen: { args: [ 'ptr', 'i32' ], returns: 'ptr' },
+        dlsym: { args: [ 'ptr', 'ptr' ], returns: 'ptr' },
+        dladdr: { args: [ 'ptr', 'ptr' ], returns: 'i32' },
+      });
+      const RTLD_LAZY = 1, RTLD_NOW = 2;
+      loader = {
+        open: (path, lazy) => symbols.dlopen(cstr(path), lazy ? RTLD_LAZY : RTLD_NOW),
+        find: (handle, name) => symbols.dlsym(handle, cstr(name)),
+        getBase: (handle, symbol) => {
+          // Dl_info: dli_fname, dli_fbase, dli_sname, dli_saddr
+          const info = new BigUint64Array(4);
+          return (symbols.dladdr(symbol, info)) ? Number(info[1]) : 0;
+        },
+      };
+    }
+  }
+  return loader;
+}
+
+function importFunctions(address) {
+  // same order as import_table in addon.h
+  const signatures = [
+    [ 'allocateExternMemory', [ 'u32', 'u64', 'u16', 'ptr' ] ],
+    [ 'freeExternMemory', [ 'u32', 'ptr' ] ],
+    [ 'getFactoryThunk', [ 'ptr' ] ],
+    [ 'runThunk', [ 'ptr', 'u64', 'ptr', 'ptr' ] ],
+    [ 'runVariadicThunk', [ 'ptr', 'u64', 'ptr', 'ptr', 'u64', 'ptr' ] ],
+    [ 'overrideWrite', [ 'ptr', 'u64' ] ],
+    [ 'createThreadPool', [ 'u64', 'ptr' ] ],
+  ];
+  const functions = {};
+  for (const [ index, [ name, args ] ] of signatures.entries()) {
+    functions[name] = CFunction({ ptr: read.ptr(address, index * 8), args, returns: 'u32' });
+  }
+  return functions;
+}
+
+let exportCallbacks = null;
+
+function exportFunctions(address) {
+  if (!exportCallbacks) {
+    exportCallbacks = createExportCallbacks();
+  }
+  // the table is shared by everyone who loads the library, hence the call context
+  const table = new BigUint64Array(toArrayBuffer(address, 0, exportCallbacks.length * 8));
+  for (const [ index, callback ] of exportCallbacks.entries()) {
+    table[index] = BigInt(callback);
+  }
+}
+
+function createExportCallbacks() {
+  const writeValue = (dest, env, value) => {
+    new BigUint64Array(toArrayBuffer(dest, 0, 8))[0] = BigInt(env.getObjectIndex(value));
+  };
+  const readMemory = (mem) => {
+    const attributes = read.u32(mem, 16);
+    return {
+      address: BigInt(read.ptr(mem, 0) ?? 0),
+      len: Number(read.u64(mem, 8)),
+      align: attributes & 0xffff,
+      isComptime: !!(attributes & 0x20000),
+    };
+  };
+  const readString = (address) => (address) ? new CString(address).toString() : undefined;
+  const readUsize = (address, offset) => {
+    const value = read.u64(address, offset);
+    return (value !== MISSING_USIZE) ? Number(value) : undefined;
+  };
+  const callbacks = {
+    allocateHostMemory: [ [ 'u64', 'u16', 'ptr' ], (env, len, align, dest) => {
+      len = Number(len);
+      const dv = env.allocateHostMemory(len, align);
+      if (dv.byteLength !== len) {
+        return FAILURE;
+      }
+      const mem = new BigUint64Array(toArrayBuffer(dest, 0, 24));
+      mem[0] = BigInt(env.getViewAddress(dv));
+      mem[1] = BigInt(len);
+      mem[2] = BigInt(align);
+    } ],
+    freeHostMemory: [ [ 'ptr' ], (env, mem) => {
+      const { address, len, align } = readMemory(mem);
+      env.freeHostMemory(address, len, align);
+    } ],
+    captureString: [ [ 'ptr', 'ptr' ], (env, mem, dest) => {
+      const { address, len } = readMemory(mem);
+      writeValue(dest, env, env.createString(address, len, 1));
+    } ],
+    captureView: [ [ 'ptr', 'ptr' ], (env, mem, dest) => {
+      const { address, len, isComptime } = readMemory(mem);
+      writeValue(dest, env, env.captureView(address, len, isComptime));
+    } ],
+    castView: [ [ 'ptr', 'ptr', 'ptr' ], (env, mem, structure, dest) => {
+      const { address, len, isComptime } = readMemory(mem);
+      writeValue(dest, env, env.castView(address, len, isComptime, env.getObject(structure)));
+    } ],
+    readSlot: [ [ 'ptr', 'u64', 'ptr' ], (env, object, slot, dest) => {
+      const value = env.readSlot(env.getObject(object), Number(slot));
+      if (value === undefined) {
+        return FAILURE;
+      }
+      writeValue(dest, env, value);
+    } ],
+    writeSlot: [ [ 'ptr', 'u64', 'ptr' ], (env, object, slot, value) => {
+      env.writeSlot(env.getObject(object), Number(slot), env.getObject(value));
+    } ],
+    beginStructure: [ [ 'ptr', 'ptr' ], (env, s, dest) => {
+      const def = { type: read.u32(s, 8) };
+      const length = readUsize(s, 16);
+      const byteSize = readUsize(s, 24);
+      const align = read.u16(s, 32);
+      if (length !== undefined) def.length = length;
+      if (byteSize !== undefined) def.byteSize = byteSize;
+      if (align !== MISSING_U16) def.align = align;
+      def.isConst = !!read.u8(s, 34);
+      def.isTuple = !!read.u8(s, 35);
+      def.isIterator = !!read.u8(s, 36);
+      def.hasPointer = !!read.u8(s, 37);
+      def.name = readString(read.ptr(s, 0));
+      writeValue(dest, env, env.beginStructure(def));
+    } ],
+    attachMember: [ [ 'ptr', 'ptr', 'bool' ], (env, structure, m, isStatic) => {
+      const member = { type: read.u32(m, 8), isRequired: !!read.u8(m, 12) };
+      const bitSize = readUsize(m, 24);
+      const bitOffset = readUsize(m, 16);
+      const byteSize = readUsize(m, 32);
+      const slot = readUsize(m, 40);
+      const name = readString(read.ptr(m, 0));
+      const memberStructure = read.ptr(m, 48);
+      if (bitSize !== undefined) member.bitSize = bitSize;
+      if (bitOffset !== undefined) member.bitOffset = bitOffset;
+      if (byteSize !== undefined) member.byteSize = byteSize;
+      if (slot !== undefined) member.slot = slot;
+      if (name !== undefined) member.name = name;
+      if (memberStructure) member.structure = env.getObject(memberStructure);
+      env.attachMember(env.getObject(structure), member, isStatic);
+    } ],
+    attachMethod: [ [ 'ptr', 'ptr', 'bool' ], (env, structure, m, isStaticOnly) => {
+      // thunk_id from Zig is the function's address--make it relative to the base address
+      const method = {
+        argStruct: env.getObject(read.ptr(m, 16)),
+        thunkId: Number(read.u64(m, 8)) - env.baseAddress,
+      };
+      const name = readString(read.ptr(m, 0));
+      if (name !== undefined) method.name = name;
+      env.attachMethod(env.getObject(structure), method, isStaticOnly);
+    } ],
+    attachTemplate: [ [ 'ptr', 'ptr', 'bool' ], (env, structure, template, isStatic) => {
+      env.attachTemplate(env.getObject(structure), env.getObject(template), isStatic);
+    } ],
+    finalizeShape: [ [ 'ptr' ], (env, structure) => {
+      env.finalizeShape(env.getObject(structure));
+    } ],
+    endStructure: [ [ 'ptr' ], (env, structure) => {
+      env.endStructure(env.getObject(structure));
+    } ],
+    createTemplate: [ [ 'ptr', 'ptr' ], (env, dv, dest) => {
+      writeValue(dest, env, env.createTemplate(env.getObject(dv)));
+    } ],
+    writeToConsole: [ [ 'ptr' ], (env, dv) => {
+      env.writeToConsole(env.getObject(dv));
+    } ],
+    queueCallback: null,
+    getThreadPool: [ [ 'ptr' ], (env, dest) => {
+      if (!threadPool.ptr) {
+        createThreadPool(env);
+      }
+      const pool = new BigUint64Array(toArrayBuffer(dest, 0, 16));
+      pool[0] = BigInt(threadPool.ptr);
+      pool[1] = BigInt(threadPool.vtable);
+    } ],
+  };
+  // same order as export_table in addon.h
+  return Object.values(callbacks).map((entry) => {
+    if (!entry) {
+      // called from arbitrary threads, so it's implemented in C
+      return getCallbackQueue().queueCallback;
+    }
+    const [ args, fn ] = entry;
+    const callback = new JSCallback((ctx, ...args) => {
+      try {
+        const env = contexts.get(ctx);
+        return (env && fn(env, ...args) !== FAILURE) ? OK : FAILURE;
+      } catch (err) {
+        return FAILURE;
+      }
+    }, { args: [ 'ptr', ...args ], returns: 'u32' });
+    return callback.ptr;
+  });
+}
+
+const jsCallbacks = new Map();
+let nextCallbackHandle = 1;
+let keepAlive = null;
+let callbackQueue = null;
+
+function getCallbackQueue() {
+  if (!callbackQueue) {
+    const { symbols } = cc({
+      source: fileURLToPath(new URL('./environment-bun.c', import.meta.url)),
+      symbols: {
+        set_deliver: { args: [ 'ptr' ], returns: 'void' },
+        get_queue_callback: { args: [], returns: 'ptr' },
+        free_copy: { args: [ 'ptr' ], returns: 'void' },
+      },
+    });
+    const deliver = new JSCallback((handle, copy, len) => {
+      // invoked on the JS thread, in the order in which calls were queued
+      const fn = jsCallbacks.get(Number(handle));
+      const buffer = new ArrayBuffer(Number(len));
+      if (len > 0) {
+        new Uint8Array(buffer).set(new Uint8Array(toArrayBuffer(copy, 0, Number(len))));
+      }
+      symbols.free_copy(copy);
+      if (fn) {
+        // Zig never runs a JS function synchronously, even when the call comes from the JS thread
+        queueMicrotask(() => fn(new DataView(buffer)));
+      }
+    }, { args: [ 'ptr', 'ptr', 'u64' ], returns: 'void', threadsafe: true });
+    symbols.set_deliver(deliver.ptr);
+    callbackQueue = { deliver, queueCallback: symbols.get_queue_callback() };
+  }
+  return callbackQueue;
+}
+
+// the thread pool is shared by all modules, like the one in the addon
+const threadPool = { size: 0, ptr: 0, vtable: 0 };
+
+function createThreadPool(env) {
+  if (env.zig.createThreadPool(threadPool.size, env.scratchAddress) !== OK) {
+    throw new Error('Unable to create thread pool');
+  }
+  threadPool.ptr = Number(env.scratch[0]);
+  threadPool.vtable = Number(env.scratch[1]);
+  // spawn, run_pending, get_thread_count, allocate, free, get_stats, shut_down
+  const fn = (index, args, returns) => CFunction({ ptr: read.ptr(threadPool.vtable, index * 8), args, returns });
+  threadPool.getThreadCount = fn(2, [ 'ptr' ], 'u64');
+  threadPool.getStats = fn(5, [ 'ptr', 'ptr' ], 'void');
+  threadPool.shutDown = fn(6, [ 'ptr' ], 'void');
+}
+
+function retireThreadPool() {
+  // tasks still in the queues are run before the threads exit; the pool itself is never freed,
+  // since Zig code might still be holding onto it
+  threadPool.shutDown(threadPool.ptr);
+  threadPool.ptr = threadPool.vtable = 0;
+}
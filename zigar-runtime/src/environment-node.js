@@ -1,6 +1,12 @@
-import { Environment, add, getAlignedAddress, isMisaligned } from './environment.js';
-import { InvalidDeallocation, ZigError } from './error.js';
-import { ALIGN, ATTRIBUTES, FIXED, MEMORY, POINTER_VISITOR } from './symbol.js';
+import { getAddressable } from './data-view.js';
+import { Environment, add, findSortedIndex, getAlignedAddress, isMisaligned } from './environment.js';
+import {
+  InvalidAccessHint, InvalidDeallocation, MisalignedMemory, TooManyCallbacks, TypeMismatch, ZigError
+} from './error.js';
+import { invokeCallbackInstrumented } from './instrumentation.js';
+import {
+  ALIGN, ATTRIBUTES, CALLBACK_BINDER, CALLBACK_UNBINDER, FIXED, MEMORY, POINTER_VISITOR, SLOTS
+} from './symbol.js';
 
 export class NodeEnvironment extends Environment {
   // C code will patch in these functions:
@@ -12,14 +18,33 @@ export class NodeEnvironment extends Environment {
     obtainExternBuffer: null,
     copyBytes: null,
     findSentinel: null,
+    createString: null,
+    encodeString: null,
     defineStructures: null,
     getFactoryThunk: null,
     runThunk: null,
     runVariadicThunk: null,
     getMemoryOffset: null,
     recreateAddress: null,
+    createJsCallback: null,
+    releaseJsCallback: null,
+    // the thread pool is shared by all modules; a count of zero means one thread per CPU core
+    setThreadCount: null,
+    getThreadPoolStats: null,
+    // phase timings recorded when loadModule() is called with { profile: true }
+    getLoadProfile: null,
+    // memory-mapped files, exposed as external buffers
+    mapFile: null,
+    unmapFile: null,
+    adviseMemory: null,
   };
   wordSize = [ 'arm64', 'ppc64', 'x64', 's390x' ].includes(process.arch) ? 8 : /* c8 ignore next */ 4;
+  // the addon sets this to false when the runtime (e.g. Electron) doesn't allow external buffers,
+  // in which case the buffers it returns are copies
+  externalBuffers = true;
+  // fixed memory already wrapped in a buffer, sorted by address
+  fixedRegions = [];
+  fixedRegionRegistry = null;
 
   async init() {
     return;
@@ -28,10 +53,10 @@ export class NodeEnvironment extends Environment {
   allocateRelocMemory(len, align) {
     // allocate extra memory for alignment purpose when align is larger than the default
     const extra = (align > this.wordSize * 2 && this.getBufferAddress) ? align : 0;
-    const buffer = new ArrayBuffer(len + extra);
+    const buffer = this.createBuffer(len + extra);
     let offset = 0;
     if (extra) {
-      const address = this.getBufferAddress(buffer);
+      const address = this.getBufferAddress((this.sharing) ? new DataView(buffer) : buffer);
       const aligned = getAlignedAddress(address, align);
       offset = aligned - address;
     }
@@ -61,18 +86,250 @@ export class NodeEnvironment extends Environment {
     // nothing needs to happen
   }
 
-  obtainExternView(address, len) {
+  allocateFixedArray(len, align = this.wordSize * 2, collectable = false) {
+    const dv = this.allocateFixedMemory(len, align);
+    const array = new Uint8Array(dv.buffer, dv.byteOffset, len);
+    if (collectable && len > 0) {
+      // free the memory once nothing refers to the buffer anymore
+      const { address, unalignedAddress, type } = dv[FIXED];
+      this.fixedArrayRegistry ??= new FinalizationRegistry(({ type, address, len, align }) => {
+        if (!this.released) {
+          this.freeExternMemory(type, address, len, align);
+        }
+      });
+      this.fixedArrayRegistry.register(dv.buffer, { type, address: unalignedAddress ?? address, len, align }, dv.buffer);
+    }
+    return array;
+  }
+
+  freeFixedArray(array) {
+    const dv = this.obtainView(array.buffer, array.byteOffset, array.byteLength);
+    const fixed = dv[FIXED];
+    // only a view of the whole allocation carries its attributes; a subarray or an array that has
+    // already been freed cannot be used
+    if (fixed?.type === undefined) {
+      throw new InvalidDeallocation(fixed?.address ?? 0);
+    }
+    this.fixedArrayRegistry?.unregister(dv.buffer);
+    this.releaseFixedView(dv);
+  }
+
+  obtainMappedView(path, options = {}) {
+    const { readonly = true, access = 'normal' } = options;
+    const buffer = this.mapFile(String(path), !readonly, getAccessIndex(access));
+    const len = buffer.byteLength;
+    if (len > 0) {
+      // the pages don't move, so Zig can use the memory directly, without a shadow copy
+      buffer[FIXED] = { address: this.getBufferAddress(buffer), len };
+      // pointers into the file returned by Zig will be views of this buffer
+      this.addFixedRegion(buffer);
+    }
+    return new Uint8Array(buffer);
+  }
+
+  releaseMappedView(array) {
+    const buffer = getMappedBuffer(array);
+    if (buffer.byteLength > 0) {
+      this.unmapFile(buffer);
+      this.removeFixedRegion(buffer);
+    }
+  }
+
+  adviseAccess(array, access) {
+    const buffer = getMappedBuffer(array);
+    if (buffer.byteLength > 0) {
+      // the addon checks that the buffer belongs to a mapped file
+      this.adviseMemory(buffer, array.byteOffset, array.byteLength, getAccessIndex(access));
+    }
+  }
+
+  getSpecialExports() {
+    return {
+      ...super.getSpecialExports(),
+      allocateFixed: (len, align, collectable) => this.allocateFixedArray(len, align, collectable),
+      freeFixed: (array) => this.freeFixedArray(array),
+      mapFile: (path, options) => this.obtainMappedView(path, options),
+      unmapFile: (array) => this.releaseMappedView(array),
+      advise: (array, access) => this.adviseAccess(array, access),
+      releaseCallback: (fn) => this.releaseCallback(fn),
+    };
+  }
+
+  // Zig never runs a JS function synchronously. Each call has its arguments copied into the
+  // queue of a thread-safe function and is delivered on the JS thread once the current JS code
+  // has finished. The queue is FIFO: calls made by one Zig thread arrive in the order in which
+  // they were made, while calls from different threads interleave in the order in which they
+  // entered the queue. Calls made before releaseCallback() are still delivered; calls made after
+  // are dropped. A bound function keeps the event loop alive until it is released.
+  bindCallback(structure, fn) {
+    const addresses = this.callbackAddresses ??= new Map();
+    let map = addresses.get(structure);
+    if (!map) {
+      addresses.set(structure, map = new Map());
+    }
+    let address = map.get(fn);
+    if (address === undefined) {
+      const { constructor, instance: { members: [ { structure: argStructure } ] } } = structure;
+      const ArgStruct = argStructure.constructor;
+      const argKeys = argStructure.instance.members.slice(1).map(m => m.name);
+      const handler = (dv) => {
+        // the addon has copied the arguments into a new buffer
+        const createArgs = () => {
+          const args = Object.create(ArgStruct.prototype);
+          args[MEMORY] = dv;
+          args[SLOTS] = {};
+          return argKeys.map(k => args[k]);
+        };
+        if (this.instruments) {
+          invokeCallbackInstrumented(this, address, fn.name || structure.name, createArgs, fn);
+        } else {
+          fn(...createArgs());
+        }
+      };
+      // calls from Zig go through a thread-safe function, making them possible from any thread
+      const handle = this.createJsCallback(handler);
+      address = constructor[CALLBACK_BINDER](handle);
+      if (!address) {
+        this.releaseJsCallback(handle);
+        throw new TooManyCallbacks(structure);
+      }
+      map.set(fn, address);
+      this.callbackBindings ??= new Map();
+      this.callbackBindings.set(BigInt(address), { fn, handle, structure });
+    }
+    return address;
+  }
+
+  findCallback(address) {
+    return this.callbackBindings?.get(BigInt(address))?.fn;
+  }
+
+  releaseCallback(fn) {
+    // release all bindings when no function is given
+    let count = 0;
+    for (const [ address, binding ] of this.callbackBindings ?? []) {
+      if (fn === undefined || binding.fn === fn) {
+        const { structure, handle } = binding;
+        // detach the trampoline first so that no new call is queued
+        structure.constructor[CALLBACK_UNBINDER](address);
+        this.releaseJsCallback(handle);
+        this.callbackAddresses.get(structure).delete(binding.fn);
+        this.callbackBindings.delete(address);
+        count++;
+      }
+    }
+    return count;
+  }
+
+  abandon() {
+    if (!this.abandoned) {
+      this.releaseCallback();
+    }
+    super.abandon();
+  }
+
+  obtainExternView(address, len, separate = false) {
+    // pointers into memory that has been seen before become views of the same buffer, so that
+    // an arena handing out many small objects doesn't lead to as many buffers and finalizers
+    const region = (!separate) ? this.findFixedRegion(address, len) : undefined;
+    if (region) {
+      // views of a region are not kept in viewMap, where they'd stay for as long as the region
+      // does (e.g. a mapped file)
+      const dv = new DataView(region.buffer, Number(address - region.address), len);
+      dv[FIXED] = { address, len };
+      return dv;
+    }
     const buffer = this.obtainExternBuffer(address, len);
     buffer[FIXED] = { address, len };
+    if (this.externalBuffers) {
+      this.addFixedRegion(buffer);
+    }
     return this.obtainView(buffer, 0, len);
   }
 
+  freeFixedMemory(dv) {
+    this.removeFixedRegion(dv.buffer);
+    super.freeFixedMemory(dv);
+  }
+
+  findFixedRegion(address, len) {
+    const list = this.fixedRegions;
+    const index = findSortedIndex(list, address, r => r.address);
+    const entry = list[index - 1];
+    if (entry && add(address, len) <= add(entry.address, entry.len)) {
+      const buffer = entry.ref.deref();
+      // a mapped file could have been unmapped, detaching the buffer
+      if (buffer?.byteLength > 0) {
+        return { address: entry.address, buffer };
+      }
+      this.removeFixedRegionAt(index - 1);
+    }
+  }
+
+  addFixedRegion(buffer) {
+    const { address, len } = buffer[FIXED];
+    const list = this.fixedRegions;
+    const end = add(address, len);
+    let index = findSortedIndex(list, address, r => r.address);
+    if (list[index - 1]?.address === address) {
+      index--;
+    }
+    // regions inside the new one are no longer needed for lookup
+    for (let i = index; i < list.length && list[i].address < end;) {
+      if (add(list[i].address, list[i].len) <= end) {
+        this.removeFixedRegionAt(i);
+      } else {
+        i++;
+      }
+    }
+    const entry = { address, len, ref: new WeakRef(buffer) };
+    list.splice(findSortedIndex(list, address, r => r.address), 0, entry);
+    // one finalizer per region, dropping the entry once the buffer is gone
+    this.fixedRegionRegistry ??= new FinalizationRegistry((entry) => {
+      const list = this.fixedRegions;
+      const index = findSortedIndex(list, entry.address, r => r.address);
+      // regions can share a starting address
+      for (let i = index - 1; i >= 0 && list[i].address === entry.address; i--) {
+        if (list[i] === entry) {
+          list.splice(i, 1);
+          break;
+        }
+      }
+    });
+    this.fixedRegionRegistry.register(buffer, entry, entry);
+  }
+
+  removeFixedRegion(buffer) {
+    const fixed = buffer[FIXED];
+    if (fixed) {
+      const list = this.fixedRegions;
+      const index = findSortedIndex(list, fixed.address, r => r.address);
+      if (list[index - 1]?.ref.deref() === buffer) {
+        this.removeFixedRegionAt(index - 1);
+      }
+    }
+  }
+
+  removeFixedRegionAt(index) {
+    const [ entry ] = this.fixedRegions.splice(index, 1);
+    this.fixedRegionRegistry.unregister(entry);
+  }
+
+  getPinnedAddress(object, dv) {
+    const address = this.getViewAddress(dv);
+    const align = object.constructor[ALIGN];
+    if (isMisaligned(address, align)) {
+      throw new MisalignedMemory(object, align);
+    }
+    return address;
+  }
+
   getTargetAddress(target, cluster) {
     const dv = target[MEMORY];
     if (cluster) {
       // pointer is pointing to buffer with overlapping views
       if (cluster.misaligned === undefined) {
-        const address = this.getBufferAddress(dv.buffer);
+        const address = this.getBufferAddress(getAddressable(dv));
         // ensure that all pointers are properly aligned
         for (const target of cluster.targets) {
           const offset = target[MEMORY].byteOffset;
@@ -86,6 +343,9 @@ export class NodeEnvironment extends Environment {
         if (cluster.misaligned === undefined)  {
           cluster.misaligned = false;
           cluster.address = address;
+          // register the whole region once instead of each target
+          const { start, end } = cluster;
+          this.registerMemory(this.obtainView(dv.buffer, start, end - start));
         }
       }
       if (!cluster.misaligned) {
@@ -139,3 +399,21 @@ export class NodeEnvironment extends Environment {
     return args.retval;
   }
 }
+
+const accessHints = [ 'normal', 'sequential', 'random', 'willneed', 'dontneed' ];
+
+function getAccessIndex(access) {
+  const index = accessHints.indexOf(access);
+  if (index === -1) {
+    throw new InvalidAccessHint(access, accessHints);
+  }
+  return index;
+}
+
+function getMappedBuffer(array) {
+  const buffer = array?.buffer;
+  if (!(array instanceof Uint8Array) || !(buffer instanceof ArrayBuffer)) {
+    throw new TypeMismatch('mapped file', array);
+  }
+  return buffer;
+}
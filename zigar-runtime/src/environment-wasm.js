@@ -213,7 +213,9 @@ export class WebAssemblyEnvironment extends Environment {
   exportFunctions() {
     const imports = {};
     for (const [ name, { argType, returnType, alias } ] of Object.entries(this.exports)) {
-      const fn = this[alias ?? name];
+      const key = alias ?? name;
+      // look up the method at call time so that it can be instrumented
+      const fn = this[key] && function(...args) { return this[key](...args) };
       imports[`_${name}`] = this.exportFunction(fn, argType, returnType);
     }
     return imports;
@@ -1,15 +1,19 @@
+import { getAddressable } from './data-view.js';
 import { resetGlobalErrorSet } from './error-set.js';
-import { AlignmentConflict, MustBeOverridden } from './error.js';
+import { AlignmentConflict, MustBeOverridden, TypeMismatch, Unsupported } from './error.js';
 import { useBool, useObject } from './member.js';
+import { addInstrument, invokeInstrumented, removeInstrument } from './instrumentation.js';
 import { getMemoryCopier } from './memory.js';
 import { addMethods } from './method.js';
 import { defineProperties, getMemoryRestorer } from './object.js';
 import { addStaticMembers } from './static.js';
+import { CallStatistics } from './statistics.js';
+import { CallTracer } from './tracing.js';
 import { findAllObjects, getStructureFactory, useArgStruct } from './structure.js';
 import {
   ADDRESS_SETTER, ALIGN,
   CONST_TARGET, COPIER, ENVIRONMENT, FIXED, LENGTH_SETTER, MEMORY,
-  MEMORY_RESTORER,
+  MEMORY_RESTORER, PACKED,
   POINTER, POINTER_VISITOR, SIZE, SLOTS, TARGET_GETTER, TARGET_UPDATER, TYPE, WRITE_DISABLER
 } from './symbol.js';
 import { decodeText } from './text.js';
@@ -22,11 +26,22 @@ export class Environment {
   consoleTimeout = 0;
   viewMap = new WeakMap();
   emptyBuffer = new ArrayBuffer(0);
+  sharing = false;
+  pinnedViews = null;
+  pinnedList = null;
+  startupTimes = {};
   abandoned = false;
   released = false;
   littleEndian = true;
   wordSize = 4;
   runtimeSafety = true;
+  lazyStructures = true;
+  arrayProxy = true;
+  pointerProxy = true;
+  int64AsNumber = false;
+  statistics = null;
+  tracer = null;
+  instruments = null;
   comptime = false;
   /* COMPTIME-ONLY */
   slots = {};
@@ -34,6 +49,7 @@ export class Environment {
   /* COMPTIME-ONLY-END */
   /* RUNTIME-ONLY */
   variables = [];
+  variablesLinked = false;
   /* RUNTIME-ONLY-END */
   imports;
   console = globalThis.console;
@@ -80,7 +96,7 @@ export class Environment {
     throw new MustBeOverridden();
   }
 
-  obtainExternView(address, len) {
+  obtainExternView(address, len, separate) {
     // obtain view of memory at specified address
     throw new MustBeOverridden();
   }
@@ -133,7 +149,8 @@ export class Environment {
 
   allocateFixedMemory(len, align, type = MemoryType.Normal) {
     const address = (len) ? this.allocateExternMemory(type, len, align) : 0;
-    const dv = this.obtainFixedView(address, len);
+    // new memory gets a buffer of its own, as its view will carry the allocation's attributes
+    const dv = this.obtainFixedView(address, len, true);
     dv[FIXED].align = align;
     dv[FIXED].type = type;
     return dv;
@@ -146,10 +163,10 @@ export class Environment {
     }
   }
 
-  obtainFixedView(address, len) {
+  obtainFixedView(address, len, separate = false) {
     let dv;
     if (address && len) {
-      dv = this.obtainExternView(address, len);
+      dv = this.obtainExternView(address, len, separate);
     } else {
       // pointer to nothing
       let entry = this.viewMap.get(this.emptyBuffer);
@@ -175,7 +192,11 @@ export class Environment {
   }
 
   allocateRelocMemory(len, align) {
-    return this.obtainView(new ArrayBuffer(len), 0, len);
+    return this.obtainView(this.createBuffer(len), 0, len);
+  }
+
+  createBuffer(len) {
+    return (this.sharing) ? new SharedArrayBuffer(len) : new ArrayBuffer(len);
   }
 
   registerMemory(dv, targetDV = null, targetAlign = undefined) {
@@ -206,39 +227,82 @@ export class Environment {
     } else if (!address && count) {
       return null;
     }
-    let len = count * (size ?? 0);
-    // check for null address (=== can't be used since address can be both number and bigint)
-    if (this.context) {
-      const { memoryList } = this.context;
-      const index = findMemoryIndex(memoryList, address);
-      const entry = memoryList[index - 1];
-      if (entry?.address === address && entry.len === len) {
-        return entry.targetDV ?? entry.dv;
-      } else if (entry?.address <= address && address < add(entry.address, entry.len)) {
-        const offset = Number(address - entry.address);
-        const targetDV = entry.targetDV ?? entry.dv;
-        const isOpaque = size === undefined;
-        if (isOpaque) {
-          len = targetDV.byteLength - offset;
-        }
-        const dv = this.obtainView(targetDV.buffer, targetDV.byteOffset + offset, len);
-        if (isOpaque) {
-          // opaque structure--need to save the alignment
-          dv[ALIGN] = entry.targetAlign;
-        }
-        return dv;
-      }
+    const len = count * (size ?? 0);
+    // look among memory registered during the call, then among pinned objects
+    const dv = (this.context && this.findMemoryIn(this.context.memoryList, address, len, size))
+            ?? (this.pinnedList && this.findMemoryIn(this.pinnedList, address, len, size));
+    if (dv) {
+      return dv;
     }
     // not found in any of the buffers we've seen--assume it's fixed memory
     return this.obtainFixedView(address, len);
   }
 
+  findMemoryIn(memoryList, address, len, size) {
+    // check for null address (=== can't be used since address can be both number and bigint)
+    const index = findMemoryIndex(memoryList, address);
+    const entry = memoryList[index - 1];
+    if (entry?.address === address && entry.len === len) {
+      return entry.targetDV ?? entry.dv;
+    } else if (entry?.address <= address && address < add(entry.address, entry.len)) {
+      const offset = Number(address - entry.address);
+      const targetDV = entry.targetDV ?? entry.dv;
+      const isOpaque = size === undefined;
+      if (isOpaque) {
+        len = targetDV.byteLength - offset;
+      }
+      const dv = this.obtainView(targetDV.buffer, targetDV.byteOffset + offset, len);
+      if (isOpaque) {
+        // opaque structure--need to save the alignment
+        dv[ALIGN] = entry.targetAlign;
+      }
+      return dv;
+    }
+  }
+
+  pin(object) {
+    const dv = object?.[MEMORY];
+    if (!dv) {
+      throw new TypeMismatch('Zig object', object);
+    }
+    // fixed memory doesn't move and is never garbage-collected
+    if (!dv[FIXED]) {
+      const views = this.pinnedViews ??= new Map();
+      let entry = views.get(dv);
+      if (!entry) {
+        // the address is obtained once; the entry keeps the buffer alive, so Zig can hold onto
+        // the pointer across calls
+        const address = this.getPinnedAddress(object, dv);
+        const list = this.pinnedList ??= [];
+        entry = { address, dv, len: dv.byteLength, count: 0 };
+        list.splice(findMemoryIndex(list, address), 0, entry);
+        views.set(dv, entry);
+      }
+      entry.count++;
+    }
+    return object;
+  }
+
+  unpin(object) {
+    const dv = object?.[MEMORY];
+    const entry = this.pinnedViews?.get(dv);
+    if (entry && --entry.count === 0) {
+      this.pinnedViews.delete(dv);
+      this.pinnedList.splice(this.pinnedList.indexOf(entry), 1);
+    }
+  }
+
+  getPinnedAddress(object, dv) {
+    // relocatable memory can only be accessed directly in Node
+    throw new Unsupported();
+  }
+
   getViewAddress(dv) {
     const fixed = dv[FIXED];
     if (fixed) {
       return fixed.address;
     } else {
-      const address = this.getBufferAddress(dv.buffer);
+      const address = this.getBufferAddress(getAddressable(dv));
       return add(address, dv.byteOffset);
     }
   }
@@ -462,14 +526,23 @@ export class Environment {
     const {
       omitFunctions = false,
       omitVariables = isElectron(),
+      omitArrayProxy = false,
+      omitPointerProxy = false,
+      int64AsNumber = false,
+      int64AsNumberTypes,
     } = options;
+    this.arrayProxy = !omitArrayProxy;
+    this.pointerProxy = !omitPointerProxy;
+    this.int64AsNumber = int64AsNumberTypes ?? int64AsNumber;
     resetGlobalErrorSet();
     const thunkId = this.getFactoryThunk();
     const ArgStruct = this.defineFactoryArgStruct();
     const args = new ArgStruct([ { omitFunctions, omitVariables } ]);
+    const start = performance.now();
     this.comptime = true;
     this.invokeThunk(thunkId, args);
     this.comptime = false;
+    this.startupTimes.structures = performance.now() - start;
   }
 
   getRootModule() {
@@ -485,10 +558,12 @@ export class Environment {
   exportStructures() {
     this.acquireDefaultPointers();
     this.prepareObjectsForExport();
-    const { structures, runtimeSafety, littleEndian } = this;
+    const {
+      structures, runtimeSafety, littleEndian, arrayProxy, pointerProxy, int64AsNumber
+    } = this;
     return {
       structures,
-      options: { runtimeSafety, littleEndian },
+      options: { runtimeSafety, littleEndian, arrayProxy, pointerProxy, int64AsNumber },
       keys: { MEMORY, SLOTS, CONST_TARGET },
     };
   }
@@ -569,16 +644,22 @@ export class Environment {
 
   createCaller(method, useThis) {
     const { name, argStruct, thunkId } = method;
-    const { constructor } = argStruct;
     const self = this;
+    const call = function(args, offset) {
+      // the arg struct's class might not be defined yet
+      if (self.instruments) {
+        return invokeInstrumented(self, thunkId, name, () => new argStruct.constructor(args, name, offset));
+      }
+      return self.invokeThunk(thunkId, new argStruct.constructor(args, name, offset));
+    };
     let f;
     if (useThis) {
       f = function(...args) {
-        return self.invokeThunk(thunkId, new constructor([ this, ...args ], name, 1));
+        return call([ this, ...args ], 1);
       }
     } else {
       f = function(...args) {
-        return self.invokeThunk(thunkId, new constructor(args, name, 0));
+        return call(args, 0);
       }
     }
     Object.defineProperty(f, 'name', { value: name });
@@ -587,6 +668,7 @@ export class Environment {
 
   /* RUNTIME-ONLY */
   recreateStructures(structures, options) {
+    const start = performance.now();
     Object.assign(this, options);
     const insertObjects = (dest, placeholders) => {
       for (const [ slot, placeholder ] of Object.entries(placeholders)) {
@@ -615,6 +697,10 @@ export class Environment {
             // need to replace dataview with one pointing to fixed memory later,
             // when the VM is up and running
             this.variables.push({ reloc, object });
+            if (this.variablesLinked) {
+              // object is materialized after linkage has occurred
+              this.linkObject(object, reloc, false);
+            }
           }
           return object;
         }
@@ -624,6 +710,23 @@ export class Environment {
     };
     resetGlobalErrorSet();
     const objectPlaceholders = new Map();
+    const materialize = (structure) => {
+      // replace accessor with regular property
+      defineProperties(structure, {
+        constructor: { value: null, enumerable: true, writable: true },
+      });
+      this.finalizeShape(structure);
+      // insert objects into template slots
+      for (const scope of [ structure.instance, structure.static ]) {
+        const slots = scope.template?.[SLOTS];
+        if (slots) {
+          insertObjects(slots, objectPlaceholders.get(slots));
+        }
+      }
+      // add static members, methods, etc.
+      this.finalizeStructure(structure);
+    };
+    const deferred = [];
     for (const structure of structures) {
       // recreate the actual template using the provided placeholder
       for (const scope of [ structure.instance, structure.static ]) {
@@ -641,19 +744,39 @@ export class Environment {
           }
         }
       }
-      this.finalizeShape(structure);
+      // error sets add their errors to anyerror so they can't wait
+      if (this.lazyStructures && structure.type !== StructureType.ErrorSet) {
+        // define the class only when the constructor is first accessed
+        defineProperties(structure, {
+          constructor: {
+            get() {
+              materialize(structure);
+              return structure.constructor;
+            },
+            enumerable: true,
+          },
+        });
+      } else {
+        this.finalizeShape(structure);
+        deferred.push(structure);
+      }
     }
-    // insert objects into template slots
-    for (const [ slots, placeholders ] of objectPlaceholders) {
-      insertObjects(slots, placeholders);
+    for (const structure of deferred) {
+      for (const scope of [ structure.instance, structure.static ]) {
+        const slots = scope.template?.[SLOTS];
+        if (slots) {
+          insertObjects(slots, objectPlaceholders.get(slots));
+        }
+      }
     }
-    // add static members, methods, etc.
-    for (const structure of structures) {
+    for (const structure of deferred) {
       this.finalizeStructure(structure);
     }
+    this.startupTimes.structures = performance.now() - start;
   }
 
   linkVariables(writeBack) {
+    const start = performance.now();
     const pointers = [];
     for (const { object, reloc } of this.variables) {
       this.linkObject(object, reloc, writeBack);
@@ -669,6 +792,8 @@ export class Environment {
       pointer[ADDRESS_SETTER](address);
       pointer[LENGTH_SETTER]?.(target.length);
     }
+    this.variablesLinked = true;
+    this.startupTimes.variables = performance.now() - start;
   }
 
   linkObject(object, reloc, writeBack) {
@@ -705,6 +830,7 @@ export class Environment {
     for (const { object } of this.variables) {
       this.unlinkObject(object);
     }
+    this.variablesLinked = false;
   }
 
   unlinkObject(object) {
@@ -744,13 +870,82 @@ export class Environment {
       sizeOf: (T) => check(T[SIZE]),
       alignOf: (T) => check(T[ALIGN]),
       typeOf: (T) => getStructureName(check(T[TYPE])),
+      stats: (options) => this.getStatistics(options),
+      pin: (object) => this.pin(object),
+      unpin: (object) => this.unpin(object),
+      trace: (enabled) => this.setTracing(enabled),
+      setThreadCount: (count) => this.setThreadCount(count),
+      threadPoolStats: () => this.getThreadPoolStats(),
+      startupProfile: () => this.getStartupProfile(),
     };
   }
 
+  getStatistics(options = {}) {
+    const { collect, reset = false } = options;
+    if (collect === true && !this.statistics) {
+      this.statistics = new CallStatistics();
+      addInstrument(this, this.statistics);
+    }
+    const result = this.statistics?.report() ?? [];
+    if (reset) {
+      this.statistics?.reset();
+    }
+    if (collect === false && this.statistics) {
+      removeInstrument(this, this.statistics);
+      this.statistics = null;
+    }
+    return result;
+  }
+
+  setTracing(enabled = true) {
+    const before = !!this.tracer;
+    if (enabled && !this.tracer) {
+      this.tracer = new CallTracer();
+      addInstrument(this, this.tracer);
+    } else if (!enabled && this.tracer) {
+      removeInstrument(this, this.tracer);
+      this.tracer = null;
+    }
+    return before;
+  }
+
+  bindCallback(structure, fn) {
+    // only the Node environment can call JavaScript from other threads
+    throw new Unsupported();
+  }
+
+  findCallback(address) {
+    return undefined;
+  }
+
+  setThreadCount(count) {
+    // the thread pool is provided by the Node addon
+    throw new Unsupported();
+  }
+
+  getThreadPoolStats() {
+    return null;
+  }
+
+  getLoadProfile() {
+    // only the Node addon times the loading of modules
+    return null;
+  }
+
+  getStartupProfile() {
+    // times are in milliseconds; null unless profiling was requested when the module was loaded
+    const profile = this.getLoadProfile();
+    if (!profile) {
+      return null;
+    }
+    return { ...profile, ...this.startupTimes };
+  }
+
   abandon() {
     if (!this.abandoned) {
       this.releaseFunctions();
       this.unlinkVariables();
+      this.pinnedViews = this.pinnedList = null;
       this.abandoned = true;
     }
   }
@@ -772,18 +967,22 @@ export class Environment {
             // only relocatable targets need updating
             const dv = target[MEMORY];
             if (!dv[FIXED]) {
-              // see if the buffer is shared with other objects
-              const other = bufferMap.get(dv.buffer);
-              if (other) {
-                const array = Array.isArray(other) ? other : [ other ];
-                const index = findSortedIndex(array, dv.byteOffset, t => t[MEMORY].byteOffset);
-                array.splice(index, 0, target);
-                if (!Array.isArray(other)) {
-                  bufferMap.set(dv.buffer, array);
-                  potentialClusters.push(array);
+              // pinned objects already have an address, but pointers inside them still need to be
+              // written
+              if (!env.pinnedViews?.has(dv)) {
+                // see if the buffer is shared with other objects
+                const other = bufferMap.get(dv.buffer);
+                if (other) {
+                  const array = Array.isArray(other) ? other : [ other ];
+                  const index = findSortedIndex(array, dv.byteOffset, t => t[MEMORY].byteOffset);
+                  array.splice(index, 0, target);
+                  if (!Array.isArray(other)) {
+                    bufferMap.set(dv.buffer, array);
+                    potentialClusters.push(array);
+                  }
+                } else {
+                  bufferMap.set(dv.buffer, target);
                 }
-              } else {
-                bufferMap.set(dv.buffer, target);
               }
               // scan pointers in target
               target[POINTER_VISITOR]?.(callback);
@@ -804,7 +1003,11 @@ export class Environment {
     // process the pointers
     for (const [ pointer, target ] of pointerMap) {
       const cluster = clusterMap.get(target);
-      const address = this.getTargetAddress(target, cluster) ?? this.getShadowAddress(target, cluster);
+      // pinned objects don't need to be registered or checked for alignment
+      const pinned = this.pinnedViews?.get(target[MEMORY]);
+      const address = pinned?.address
+                   ?? this.getTargetAddress(target, cluster)
+                   ?? this.getShadowAddress(target, cluster);
       // update the pointer
       pointer[ADDRESS_SETTER](address);
       pointer[LENGTH_SETTER]?.(target.length);
@@ -814,6 +1017,23 @@ export class Environment {
   findTargetClusters(potentialClusters) {
     const clusters = [];
     for (const targets of potentialClusters) {
+      const { buffer } = targets[0][MEMORY];
+      if (buffer[PACKED]) {
+        // strings packed into one buffer are handled as a single region
+        let end = 0;
+        for (const target of targets) {
+          const { byteOffset, byteLength } = target[MEMORY];
+          end = Math.max(end, byteOffset + byteLength);
+        }
+        clusters.push({
+          targets,
+          start: targets[0][MEMORY].byteOffset,
+          end,
+          address: undefined,
+          misaligned: undefined,
+        });
+        continue;
+      }
       let prevTarget = null, prevStart = 0, prevEnd = 0;
       let currentCluster = null;
       for (const target of targets) {
@@ -988,6 +1208,7 @@ export class Environment {
 
   updatePointerTargets(args) {
     const pointerMap = new Map();
+    const env = this;
     const callback = function({ isActive, isMutable }) {
       // bypass proxy
       const pointer = this[POINTER] ?? this;
@@ -1001,6 +1222,9 @@ export class Environment {
         // update targets of pointers in original target (which could have been altered)
         currentTarget?.[POINTER_VISITOR]?.(callback, { vivificate: true, isMutable: () => writable });
         if (newTarget !== currentTarget) {
+          if (newTarget?.constructor.child?.[TYPE] === StructureType.SlicePointer) {
+            env.registerTargetRegion(newTarget);
+          }
           // acquire targets of pointers in new target
           newTarget?.[POINTER_VISITOR]?.(callback, { vivificate: true, isMutable: () => writable });
         }
@@ -1009,6 +1233,53 @@ export class Environment {
     args[POINTER_VISITOR](callback, { vivificate: true });
   }
 
+  registerTargetRegion(list) {
+    // a list of slices from Zig (e.g. [][]const u8) tends to point into a single allocation;
+    // registering the span it covers lets the targets be obtained as views of one buffer instead
+    // of each needing a buffer of its own
+    const { length } = list;
+    if (length < 2 || !this.context) {
+      return;
+    }
+    const Pointer = list.constructor.child;
+    const elementSize = Pointer.child[SIZE];
+    const addressSize = Pointer[SIZE] / 2;
+    const dv = list[MEMORY];
+    const { littleEndian } = this;
+    let start, end, total = 0;
+    for (let i = 0, offset = 0; i < length; i++, offset += addressSize * 2) {
+      const address = (addressSize === 8)
+      ? dv.getBigUint64(offset, littleEndian)
+      : dv.getUint32(offset, littleEndian);
+      const count = (addressSize === 8)
+      ? Number(dv.getBigUint64(offset + 8, littleEndian))
+      : dv.getUint32(offset + 4, littleEndian);
+      const len = count * elementSize;
+      if (len > 0 && !isInvalidAddress(address)) {
+        const last = add(address, len);
+        if (start === undefined || address < start) {
+          start = address;
+        }
+        if (end === undefined || last > end) {
+          end = last;
+        }
+        total += len;
+      }
+    }
+    if (start === undefined) {
+      return;
+    }
+    const span = Number(end - start);
+    // not worthwhile when the targets are scattered about; memory from JavaScript shouldn't get
+    // shadowed by a view into the same bytes either
+    if (span > total * 2 + 4096
+     || overlapsMemory(this.context.memoryList, start, end)
+     || overlapsMemory(this.pinnedList, start, end)) {
+      return;
+    }
+    this.registerMemory(this.obtainFixedView(start, span));
+  }
+
   writeToConsole(dv) {
     const { console } = this;
     try {
@@ -1093,6 +1364,15 @@ function findMemoryIndex(array, address) {
   return findSortedIndex(array, address, m => m.address);
 }
 
+function overlapsMemory(array, start, end) {
+  if (!array) {
+    return false;
+  }
+  const index = findMemoryIndex(array, start);
+  const prev = array[index - 1], next = array[index];
+  return (prev && add(prev.address, prev.len) > start) || (next && next.address < end);
+}
+
 export function isMisaligned(address, align) {
   if (align === undefined) {
     return false;
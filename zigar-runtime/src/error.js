@@ -313,6 +313,13 @@ export class Overflow extends TypeError {
   }
 }
 
+export class UnsafeInteger extends TypeError {
+  constructor(member, value) {
+    const typeName = getTypeName(member);
+    super(`${typeName} value cannot be represented exactly as a number: ${value}`);
+  }
+}
+
 export class OutOfBound extends RangeError {
   constructor(member, index) {
     const { name } = member;
@@ -368,6 +375,34 @@ export class InvalidVariadicArgument extends TypeError {
   }
 }
 
+export class InvalidCallback extends TypeError {
+  constructor(structure, arg) {
+    const { name } = structure;
+    const type = (arg === null) ? 'null' : typeof(arg);
+    super(`${name} expects a function, received ${article(type)} ${type}`);
+  }
+}
+
+export class TooManyCallbacks extends Error {
+  constructor(structure) {
+    const { name } = structure;
+    super(`Unable to bind more functions to ${name}, release some with releaseCallback()`);
+  }
+}
+
+export class MisalignedMemory extends TypeError {
+  constructor(object, align) {
+    const { name } = object.constructor;
+    super(`Memory of ${name} is not aligned to a ${align}-byte boundary and cannot be pinned`);
+  }
+}
+
+export class InvalidAccessHint extends TypeError {
+  constructor(access, hints) {
+    super(`Access hint must be one of the following: ${hints.join(', ')}, received ${access}`);
+  }
+}
+
 export class ZigError extends Error {
   constructor(name) {
     super(deanimalizeErrorName(name));
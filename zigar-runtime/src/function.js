@@ -0,0 +1,52 @@
+import { getCompatibleTags } from './data-view.js';
+import { InvalidCallback } from './error.js';
+import { getDescriptor } from './member.js';
+import { getDestructor, getMemoryCopier } from './memory.js';
+import { attachDescriptors, createConstructor } from './object.js';
+import { convertToJSON, getDataViewDescriptor, getValueOf } from './special.js';
+import { ALIGN, COMPAT, COPIER, SIZE, TYPE } from './symbol.js';
+import { MemberType } from './types.js';
+
+export function defineFunction(structure, env) {
+  const {
+    byteSize,
+    align,
+  } = structure;
+  // the function pointer is stored as a plain address
+  const { get: getAddress, set: setAddress } = getDescriptor({
+    type: MemberType.Uint,
+    bitOffset: 0,
+    bitSize: byteSize * 8,
+    byteSize,
+    structure: { name: 'usize', byteSize },
+  }, env);
+  const initializer = function(arg) {
+    if (arg instanceof constructor) {
+      this[COPIER](arg);
+    } else if (typeof(arg) === 'function') {
+      // the JS function is bound to one of the trampolines generated for the function type
+      setAddress.call(this, env.bindCallback(structure, arg));
+    } else if (arg !== undefined) {
+      throw new InvalidCallback(structure, arg);
+    }
+  };
+  const getFunction = function() {
+    return env.findCallback(getAddress.call(this)) ?? null;
+  };
+  const constructor = structure.constructor = createConstructor(structure, { initializer }, env);
+  const instanceDescriptors = {
+    $: { get: getFunction, set: initializer },
+    dataView: getDataViewDescriptor(structure),
+    valueOf: { value: getValueOf },
+    toJSON: { value: convertToJSON },
+    delete: { value: getDestructor(env) },
+    [COPIER]: { value: getMemoryCopier(byteSize) },
+  };
+  const staticDescriptors = {
+    [COMPAT]: { value: getCompatibleTags(structure) },
+    [ALIGN]: { value: align },
+    [SIZE]: { value: byteSize },
+    [TYPE]: { value: structure.type },
+  };
+  return attachDescriptors(constructor, instanceDescriptors, staticDescriptors, env);
+}
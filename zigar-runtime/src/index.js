@@ -23,7 +23,7 @@ export {
 } from './member.js';
 export {
     useArgStruct, useArray, useBareUnion, useCPointer, useEnum, useErrorSet, useErrorUnion,
-    useExternStruct, useExternUnion, useMultiPointer, useOpaque, useOptional, usePackedStruct,
+    useExternStruct, useExternUnion, useFunction, useMultiPointer, useOpaque, useOptional, usePackedStruct,
     usePrimitive, useSinglePointer, useSlice, useSlicePointer, useStruct, useTaggedUnion, useVariadicStruct,
     useVector
 } from './structure.js';
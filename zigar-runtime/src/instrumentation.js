@@ -0,0 +1,93 @@
+// methods called during the different phases of a function call
+const phases = {
+  updatePointerAddresses: 'pointers',
+  updateShadows: 'copy-in',
+  runThunk: 'native',
+  runVariadicThunk: 'native',
+  updateShadowTargets: 'copy-out',
+  updatePointerTargets: 'targets',
+  flushConsole: 'console',
+  addShadow: 'shadow',
+  copyBytes: 'copy',
+  allocateHostMemory: 'allocate',
+  freeHostMemory: 'free',
+};
+
+export function addInstrument(env, instrument) {
+  if (!env.instruments) {
+    // wrap methods on the instance so there's no cost at all when nothing is being measured
+    const originals = {};
+    for (const [ name, phase ] of Object.entries(phases)) {
+      const f = env[name];
+      if (typeof(f) === 'function') {
+        // remember whether the function was patched onto the instance (by the addon, for instance)
+        originals[name] = Object.getOwnPropertyDescriptor(env, name);
+        env[name] = function(...args) {
+          return measure(this, phase, () => f.apply(this, args), args);
+        };
+      }
+    }
+    env.instruments = [];
+    env.instrumentedMethods = originals;
+  }
+  if (!env.instruments.includes(instrument)) {
+    env.instruments.push(instrument);
+  }
+}
+
+export function removeInstrument(env, instrument) {
+  const { instruments } = env;
+  const index = instruments?.indexOf(instrument) ?? -1;
+  if (index !== -1) {
+    instruments.splice(index, 1);
+    if (instruments.length === 0) {
+      for (const [ name, descriptor ] of Object.entries(env.instrumentedMethods)) {
+        if (descriptor) {
+          Object.defineProperty(env, name, descriptor);
+        } else {
+          delete env[name];
+        }
+      }
+      env.instruments = null;
+      env.instrumentedMethods = null;
+    }
+  }
+}
+
+export function invokeInstrumented(env, thunkId, name, createArgs) {
+  let cb = () => {
+    const args = measure(env, 'arguments', createArgs);
+    return env.invokeThunk(thunkId, args);
+  };
+  for (const instrument of env.instruments) {
+    const next = cb;
+    cb = () => instrument.call(thunkId, name, next);
+  }
+  return cb();
+}
+
+// calls from Zig to a JavaScript function are recorded like calls in the other direction, under
+// the address of the callback
+export function invokeCallbackInstrumented(env, address, name, createArgs, fn) {
+  let cb = () => {
+    const args = measure(env, 'arguments', createArgs);
+    return measure(env, 'callback', () => fn(...args));
+  };
+  for (const instrument of env.instruments) {
+    const next = cb;
+    cb = () => instrument.call(address, name, next);
+  }
+  return cb();
+}
+
+function measure(env, phase, cb, args) {
+  const { instruments } = env;
+  if (!instruments) {
+    return cb();
+  }
+  for (const instrument of instruments) {
+    const next = cb;
+    cb = () => instrument.measure(phase, next, env, args);
+  }
+  return cb();
+}
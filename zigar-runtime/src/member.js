@@ -1,10 +1,10 @@
 import {
-  getBoolAccessor, getNumericAccessor, useExtendedBool, useExtendedFloat, useExtendedInt,
-  useExtendedUint
+  getBoolAccessor, getNumberAccessor, getNumericAccessor, useExtendedBool, useExtendedFloat,
+  useExtendedInt, useExtendedUint
 } from './data-view.js';
 import {
-  EnumExpected, ErrorExpected, NotInErrorSet, NotUndefined, OutOfBound, Overflow, Unsupported,
-  adjustRangeError
+  EnumExpected, ErrorExpected, NotInErrorSet, NotUndefined, OutOfBound, Overflow, UnsafeInteger,
+  Unsupported, adjustRangeError
 } from './error.js';
 import { GETTER, MEMORY, MEMORY_RESTORER, SETTER, SLOTS, VIVIFICATOR } from './symbol.js';
 import { MemberType, StructureType, getIntRange } from './types.js';
@@ -155,17 +155,41 @@ export function getBoolDescriptor(member, env) {
 }
 
 export function getIntDescriptor(member, env) {
-  const getDataViewAccessor = addRuntimeCheck(env, getNumericAccessor);
+  const getDataViewAccessor = addRuntimeCheck(env, getIntAccessorGetter(member, env));
   const descriptor = getDescriptorUsing(member, env, getDataViewAccessor);
   return transformDescriptor(descriptor, member);
 }
 
 export function getUintDescriptor(member, env) {
-  const getDataViewAccessor = addRuntimeCheck(env, getNumericAccessor);
+  const getDataViewAccessor = addRuntimeCheck(env, getIntAccessorGetter(member, env));
   const descriptor = getDescriptorUsing(member, env, getDataViewAccessor);
   return transformDescriptor(descriptor, member);
 }
 
+export function isNumberMode(member, env) {
+  const {
+    int64AsNumber = false,
+  } = env;
+  const { type, bitSize, structure } = member;
+  if (!int64AsNumber || bitSize <= 32 || bitSize > 64) {
+    return false;
+  }
+  if (type !== MemberType.Int && type !== MemberType.Uint) {
+    return false;
+  }
+  // only fields of Zig types are affected; descriptors used internally (e.g. for the address and
+  // length of pointers) come with ad-hoc structures that have no type
+  if (structure?.type !== StructureType.Primitive || !structure.name) {
+    return false;
+  }
+  // a list of type names limits the mode to those types
+  return (Array.isArray(int64AsNumber)) ? int64AsNumber.includes(structure?.name) : true;
+}
+
+function getIntAccessorGetter(member, env) {
+  return (isNumberMode(member, env)) ? getNumberAccessor : getNumericAccessor;
+}
+
 function addRuntimeCheck(env, getDataViewAccessor) {
   return function (access, member) {
     const {
@@ -174,12 +198,31 @@ function addRuntimeCheck(env, getDataViewAccessor) {
     const accessor = getDataViewAccessor(access, member);
     if (runtimeSafety && access === 'set') {
       const { min, max } = getIntRange(member);
+      if (getDataViewAccessor === getNumberAccessor) {
+        return function(offset, value, littleEndian) {
+          if (value < min || value > max) {
+            throw new Overflow(member, value);
+          }
+          if (typeof(value) === 'number' && !Number.isSafeInteger(value)) {
+            throw new UnsafeInteger(member, value);
+          }
+          accessor.call(this, offset, value, littleEndian);
+        };
+      }
       return function(offset, value, littleEndian) {
         if (value < min || value > max) {
           throw new Overflow(member, value);
         }
         accessor.call(this, offset, value, littleEndian);
       };
+    } else if (runtimeSafety && getDataViewAccessor === getNumberAccessor) {
+      return function(offset, littleEndian) {
+        const value = accessor.call(this, offset, littleEndian);
+        if (!Number.isSafeInteger(value)) {
+          throw new UnsafeInteger(member, value);
+        }
+        return value;
+      };
     }
     return accessor;
   };
@@ -277,6 +320,7 @@ export function isValueExpected(structure) {
     case StructureType.Optional:
     case StructureType.Enum:
     case StructureType.ErrorSet:
+    case StructureType.Function:
       return true;
     default:
       return false;
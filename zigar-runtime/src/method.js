@@ -1,4 +1,5 @@
 import { defineProperties } from "./object.js";
+import { CALLBACK_BINDER, CALLBACK_UNBINDER, NEXT_BATCH } from "./symbol.js";
 
 export function addMethods(s, env) {
   const add = (target, { methods }, pushThis) => {
@@ -20,6 +21,13 @@ export function addMethods(s, env) {
           }
           descriptor[type] = f;
         }
+      } else if (f.name === '@next') {
+        // function used by iterators to fetch items in batches
+        descriptors[NEXT_BATCH] = { value: f, configurable: true, writable: true };
+      } else if (f.name === '@bind' || f.name === '@unbind') {
+        // functions that attach JS functions to callback pointers and detach them
+        const key = (f.name === '@bind') ? CALLBACK_BINDER : CALLBACK_UNBINDER;
+        descriptors[key] = { value: f, configurable: true, writable: true };
       } else {
         descriptors[f.name] = { value: f, configurable: true, writable: true };
       }
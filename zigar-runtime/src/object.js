@@ -99,9 +99,20 @@ export function createConstructor(structure, handlers, env) {
   const constructor = function(arg, options = {}) {
     const {
       fixed = false,
+      shared = false,
     } = options;
     const creating = this instanceof constructor;
     let self, dv;
+    if (creating && shared && !fixed && !env.sharing) {
+      // relocatable memory allocated during creation (including that of autovivificated
+      // pointer targets) comes from SharedArrayBuffer, so the object can be passed to a worker
+      env.sharing = true;
+      try {
+        return constructor.call(this, arg, { fixed });
+      } finally {
+        env.sharing = false;
+      }
+    }
     if (creating) {
       if (arguments.length === 0) {
         throw new NoInitializer(structure);
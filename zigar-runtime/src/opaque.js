@@ -3,7 +3,7 @@ import { AccessingOpaque, CreatingOpaque } from './error.js';
 import { getDestructor, getMemoryCopier } from './memory.js';
 import { attachDescriptors, createConstructor } from './object.js';
 import { convertToJSON, getDataViewDescriptor, getValueOf } from './special.js';
-import { getIteratorIterator } from './struct.js';
+import { getAsyncIteratorIterator, getIteratorIterator } from './struct.js';
 import { ALIGN, COMPAT, COPIER, SIZE, TYPE } from './symbol.js';
 
 export function defineOpaque(structure, env) {
@@ -31,6 +31,7 @@ export function defineOpaque(structure, env) {
     toJSON: { value: convertToJSON },
     delete: { value: getDestructor(env) },
     [Symbol.iterator]: getIterator && { value: getIterator },
+    [Symbol.asyncIterator]: isIterator && { value: getAsyncIteratorIterator },
     [Symbol.toPrimitive]: { value: toPrimitive },
     [COPIER]: { value: getMemoryCopier(byteSize) },
   };
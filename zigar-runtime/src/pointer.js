@@ -1,4 +1,4 @@
-import { getDataView, isCompatibleBuffer } from './data-view.js';
+import { getDataView, isCompatibleBuffer, isSharedBuffer } from './data-view.js';
 import {
   ConstantConstraint, FixedMemoryTargetRequired, InaccessiblePointer, InvalidPointerTarget,
   InvalidSliceLength, NoCastingToPointer, NullPointer, ReadOnlyTarget, throwReadOnly,
@@ -6,7 +6,7 @@ import {
 } from './error.js';
 import { getDescriptor, isValueExpected } from './member.js';
 import { getMemoryCopier } from './memory.js';
-import { attachDescriptors, createConstructor, defineProperties } from './object.js';
+import { attachDescriptors, createConstructor, defineProperties, getSelf } from './object.js';
 import { convertToJSON, getValueOf } from './special.js';
 import {
   ADDRESS, ADDRESS_SETTER, ALIGN, CONST_PROXY, CONST_TARGET, COPIER, ENVIRONMENT, FIXED, GETTER,
@@ -27,6 +27,7 @@ export function definePointer(structure, env) {
   } = structure;
   const {
     runtimeSafety = true,
+    pointerProxy = true,
   } = env;
   const { structure: targetStructure } = member;
   const { type: targetType, sentinel, byteSize: elementSize = 1 } = targetStructure;
@@ -84,6 +85,7 @@ export function definePointer(structure, env) {
       this[LENGTH] = length;
     }
   : null;
+  let constTargetNeedsProxy;
   const getTargetObject = function() {
     const pointer = this[POINTER] ?? this;
     const target = updateTarget.call(pointer, false);
@@ -93,7 +95,15 @@ export function definePointer(structure, env) {
       }
       throw new NullPointer();
     }
-    return (isConst) ? getConstProxy(target) : target;
+    if (isConst) {
+      // a read-only copy of the target can only be used when there are no child objects, which
+      // would remain writable, and when the target isn't indexed, since a copy would inherit the
+      // array proxy's set trap; those need to go through the const proxy, which wraps children too
+      constTargetNeedsProxy ??= isIndexed(targetStructure.type)
+        || targetStructure.instance.members.some(m => m.type === MemberType.Object);
+      return (pointerProxy || constTargetNeedsProxy) ? getConstProxy(target) : getConstTarget(target);
+    }
+    return target;
   };
   const setTargetObject = function(arg) {
     if (arg === undefined) {
@@ -198,13 +208,15 @@ export function definePointer(structure, env) {
       throw new NoCastingToPointer(structure);
     }
   };
-  const finalizer = function() {
+  const finalizer = (pointerProxy)
+  ? function() {
     const handlers = isPointer(targetType) ? {} : proxyHandlers;
     const proxy = new Proxy(this, handlers);
     // hide the proxy so console wouldn't display a recursive structure
     Object.defineProperty(this, PROXY, { value: proxy });
     return proxy;
-  };
+  }
+  : null;
   const initializer = function(arg) {
     const Target = targetStructure.constructor;
     if (isPointerOf(arg, Target)) {
@@ -222,7 +234,7 @@ export function definePointer(structure, env) {
         arg = arg['*']?.[MEMORY];
       } else if (arg[MEMORY]) {
         arg = arg[MEMORY];
-      } else if (arg?.buffer instanceof ArrayBuffer) {
+      } else if (arg?.buffer instanceof ArrayBuffer || isSharedBuffer(arg?.buffer)) {
         if (!(arg instanceof Uint8Array || arg instanceof DataView)) {
           const { byteOffset, byteLength } = arg;
           if (byteOffset !== undefined && byteLength !== undefined) {
@@ -311,13 +323,14 @@ export function definePointer(structure, env) {
   const constructor = structure.constructor = createConstructor(structure, { initializer, alternateCaster, finalizer }, env);
   const instanceDescriptors = {
     '*': { get: getTarget, set: setTarget },
-    '$': { get: getProxy, set: initializer },
+    '$': { get: (finalizer) ? getProxy : getSelf, set: initializer },
     length: { get: getTargetLength, set: setTargetLength },
     valueOf: { value: getValueOf },
     toJSON: { value: convertToJSON },
     delete: { value: deleteTarget },
     slice: getSliceOf && { value: getSliceOf },
     subarray: getSubarrayOf && { value: getSubarrayOf },
+    deref: !finalizer && { value: getTarget },
     [Symbol.toPrimitive]: getTargetPrimitive && { value: getTargetPrimitive },
     [TARGET_GETTER]: { value: getTargetObject },
     [TARGET_SETTER]: { value: setTargetObject },
@@ -327,6 +340,7 @@ export function definePointer(structure, env) {
     [POINTER_VISITOR]: { value: visitPointer },
     [COPIER]: { value: getMemoryCopier(byteSize) },
     [WRITE_DISABLER]: { value: makePointerReadOnly },
+    [POINTER]: !finalizer && { get: getSelf },
     [ADDRESS]: { value: undefined, writable: true },
     [LENGTH]: setLength && { value: undefined, writable: true },
   };
@@ -388,6 +402,10 @@ function visitPointer(fn, options = {}) {
   fn.call(this, { source, isActive, isMutable });
 }
 
+function isIndexed(type) {
+  return type === StructureType.Array || type === StructureType.Slice || type === StructureType.Vector;
+}
+
 function isPointerOf(arg, Target) {
   return (arg?.constructor?.child === Target && arg['*']);
 }
@@ -413,6 +431,21 @@ function getConstProxy(target) {
   return proxy;
 }
 
+function getConstTarget(target) {
+  if (target[CONST_TARGET]) {
+    // already read-only
+    return target;
+  }
+  let constTarget = target[CONST_PROXY];
+  if (!constTarget) {
+    // create a read-only object sharing the target's memory and slots
+    constTarget = Object.create(target);
+    constTarget[WRITE_DISABLER]();
+    Object.defineProperty(target, CONST_PROXY, { value: constTarget });
+  }
+  return constTarget;
+}
+
 const proxyHandlers = {
   get(pointer, name) {
     if (name === POINTER) {
@@ -452,10 +485,15 @@ const proxyHandlers = {
   },
 };
 
+const arrayWriters = [ 'set', 'setRange', 'fill' ];
+
 const constTargetHandlers = {
   get(target, name) {
     if (name === CONST_TARGET) {
       return target;
+    } else if (arrayWriters.includes(name) && isIndexed(target.constructor[TYPE])) {
+      // methods obtained through an array proxy are bound to the array itself
+      return throwReadOnly;
     } else {
       const value = target[name];
       if (value?.[CONST_TARGET] === null) {
@@ -1,14 +1,15 @@
 import {
-  canBeString, createArrayProxy, getArrayEntries, getArrayIterator, getChildVivificator,
-  getPointerVisitor, makeArrayReadOnly, transformIterable
+  adjustIndex, canBeString, createArrayProxy, getArrayEntries, getArrayIterator, getBulkCopier,
+  getChildVivificator, getFlatArrayClass, getPointerVisitor, getRangeFunctions, getStringPacker,
+  makeArrayReadOnly, transformIterable
 } from './array.js';
-import { getCompatibleTags, getTypedArrayClass } from './data-view.js';
+import { getCompatibleTags, getTypedArrayClass, isTypedArray, setDataView } from './data-view.js';
 import {
   ArrayLengthMismatch, InvalidArrayInitializer, MisplacedSentinel, MissingSentinel
 } from './error.js';
 import { getDescriptor } from './member.js';
 import { getDestructor, getMemoryCopier } from './memory.js';
-import { attachDescriptors, createConstructor, createPropertyApplier } from './object.js';
+import { attachDescriptors, createConstructor, createPropertyApplier, getSelf } from './object.js';
 import { copyPointer, getProxy } from './pointer.js';
 import {
   convertToJSON, getBase64Descriptor, getDataViewDescriptor, getStringDescriptor,
@@ -63,6 +64,9 @@ export function defineSlice(structure, env) {
   // the initializer behave differently depending on whether it's called by the
   // constructor or by a member setter (i.e. after object's shape has been established)
   const propApplier = createPropertyApplier(structure);
+  const bulkCopier = getBulkCopier(structure, env);
+  const stringPacker = getStringPacker(structure, env);
+  const flatArray = getFlatArrayClass(structure);
   const initializer = function(arg, fixed = false) {
     if (arg instanceof constructor) {
       if (!this[MEMORY]) {
@@ -76,6 +80,10 @@ export function defineSlice(structure, env) {
       }
     } else if (typeof(arg) === 'string' && hasStringProp) {
       initializer.call(this, { string: arg }, fixed);
+    } else if (isTypedArray(arg, flatArray)) {
+      // elements of all vectors in one typed array
+      const dv = new DataView(arg.buffer, arg.byteOffset, arg.byteLength);
+      setDataView.call(this, dv, structure, true, fixed, { shapeDefiner });
     } else if (arg?.[Symbol.iterator]) {
       arg = transformIterable(arg);
       if (!this[MEMORY]) {
@@ -83,10 +91,18 @@ export function defineSlice(structure, env) {
       } else {
         shapeChecker.call(this, arg, arg.length);
       }
-      let i = 0;
-      for (const value of arg) {
-        sentinel?.validateValue(value, i, arg.length);
-        set.call(this, i++, value);
+      if (bulkCopier?.(this, 0, arg)) {
+        if (sentinel) {
+          for (let i = 0, len = arg.length; i < len; i++) {
+            sentinel.validateValue(arg[i], i, len);
+          }
+        }
+      } else if (!stringPacker?.(this, arg)) {
+        let i = 0;
+        for (const value of arg) {
+          sentinel?.validateValue(value, i, arg.length);
+          set.call(this, i++, value);
+        }
       }
     } else if (typeof(arg) === 'number') {
       if (!this[MEMORY] && arg >= 0 && isFinite(arg)) {
@@ -105,20 +121,6 @@ export function defineSlice(structure, env) {
   const getLength = function() {
     return this[LENGTH];
   };
-  const adjustIndex = function(index, len) {
-    index = index | 0;
-    if (index < 0) {
-      index = len + index;
-      if (index < 0) {
-        index = 0;
-      }
-    } else {
-      if (index > len) {
-        index = len;
-      }
-    }
-    return index;
-  };
   function getSubArrayView(begin, end) {
     begin = (begin === undefined) ? 0 : adjustIndex(begin, this.length);
     end = (end === undefined) ? this.length : adjustIndex(end, this.length);
@@ -141,21 +143,25 @@ export function defineSlice(structure, env) {
     copier.call(slice, { [MEMORY]: dv1 });
     return slice;
   };
-  const finalizer = createArrayProxy;
+  const finalizer = (env.arrayProxy !== false) ? createArrayProxy : null;
   const copier = getMemoryCopier(elementSize, true);
   const constructor = structure.constructor = createConstructor(structure, { initializer, shapeDefiner, finalizer }, env);
   const typedArray = structure.typedArray = getTypedArrayClass(member);
   const hasObject = member.type === MemberType.Object;
   const shapeHandlers = { shapeDefiner };
+  const { getRange, setRange, fill } = getRangeFunctions(structure, env);
   const instanceDescriptors = {
-    $: { get: getProxy, set: initializer },
+    $: { get: (finalizer) ? getProxy : getSelf, set: initializer },
     length: { get: getLength },
     dataView: getDataViewDescriptor(structure, shapeHandlers),
     base64: getBase64Descriptor(structure, shapeHandlers),
-    string: hasStringProp && getStringDescriptor(structure, shapeHandlers),
+    string: hasStringProp && getStringDescriptor(structure, shapeHandlers, env),
     typedArray: typedArray && getTypedArrayDescriptor(structure, shapeHandlers),
     get: { value: get },
     set: { value: set },
+    getRange: { value: getRange },
+    setRange: { value: setRange },
+    fill: { value: fill },
     entries: { value: getArrayEntries },
     slice: { value: getSliceOf },
     subarray: { value: getSubarrayOf },
@@ -1,6 +1,6 @@
 import { checkDataView, isTypedArray, setDataView } from './data-view.js';
 import { TypeMismatch } from './error.js';
-import { ENTRIES_GETTER, MEMORY, MEMORY_RESTORER, TUPLE, TYPE } from './symbol.js';
+import { ENTRIES_GETTER, FIXED, MEMORY, MEMORY_RESTORER, TUPLE, TYPE } from './symbol.js';
 import { decodeBase64, decodeText, encodeBase64, encodeText } from './text.js';
 import { StructureType } from './types.js';
 
@@ -19,8 +19,10 @@ function normalizeObject(object, forJSON) {
   const error = (forJSON) ? 'return' : 'throw';
   const resultMap = new Map();
   const process = function(value) {
-    // handle type (i.e. constructor) like a struct
-    const type = (typeof(value) === 'function') ? StructureType.Struct : value?.constructor?.[TYPE];
+    // handle type (i.e. constructor) like a struct; other functions (i.e. callbacks) are returned as is
+    const type = (typeof(value) === 'function')
+    ? (value[TYPE] !== undefined) ? StructureType.Struct : undefined
+    : value?.constructor?.[TYPE];
     if (type === undefined) {
       if (forJSON) {
         if (typeof(value) === 'bigint' && INT_MIN <= value && value <= INT_MAX) {
@@ -125,15 +127,27 @@ export function getBase64Descriptor(structure, handlers = {}) {
   });
 }
 
-export function getStringDescriptor(structure, handlers = {}) {
+export function getStringDescriptor(structure, handlers = {}, env) {
   const { sentinel, instance: { members }} = structure;
   const { byteSize: charSize } = members[0];
   return markAsSpecial({
     get() {
       const dv = this.dataView;
-      const TypedArray = (charSize === 1) ? Int8Array : Int16Array;
-      const ta = new TypedArray(dv.buffer, dv.byteOffset, this.length);
-      let str = decodeText(ta, `utf-${charSize * 8}`);
+      let str;
+      /* NODE-ONLY */
+      const fixed = dv[FIXED];
+      // the buffer of a file that has been unmapped is detached and has no bytes
+      if (fixed && env?.createString && dv.buffer.byteLength > 0) {
+        // decode directly from Zig memory
+        str = env.createString(fixed.address, this.length, charSize);
+      } else {
+      /* NODE-ONLY-END */
+        const TypedArray = (charSize === 1) ? Int8Array : Int16Array;
+        const ta = new TypedArray(dv.buffer, dv.byteOffset, this.length);
+        str = decodeText(ta, `utf-${charSize * 8}`);
+      /* NODE-ONLY */
+      }
+      /* NODE-ONLY-END */
       if (sentinel?.value !== undefined) {
         if (str.charCodeAt(str.length - 1) === sentinel.value) {
           str = str.slice(0, -1);
@@ -150,8 +164,18 @@ export function getStringDescriptor(structure, handlers = {}) {
           str = str + String.fromCharCode(sentinel.value);
         }
       }
-      const ta = encodeText(str, `utf-${charSize * 8}`);
-      const dv = new DataView(ta.buffer);
+      let dv;
+      /* NODE-ONLY */
+      if (env?.encodeString) {
+        // let the addon size the buffer and encode the string into it
+        dv = env.encodeString(str, charSize);
+      } else {
+      /* NODE-ONLY-END */
+        const ta = encodeText(str, `utf-${charSize * 8}`);
+        dv = new DataView(ta.buffer, ta.byteOffset, ta.byteLength);
+      /* NODE-ONLY */
+      }
+      /* NODE-ONLY-END */
       setDataView.call(this, dv, structure, false, fixed, handlers);
     },
   });
@@ -159,6 +183,9 @@ export function getStringDescriptor(structure, handlers = {}) {
 
 export function getTypedArrayDescriptor(structure, handlers = {}) {
   const { typedArray } = structure;
+  if (structure.type === StructureType.Vector) {
+    return getVectorTypedArrayDescriptor(structure);
+  }
   return markAsSpecial({
     get() {
       const dv = this.dataView;
@@ -175,6 +202,24 @@ export function getTypedArrayDescriptor(structure, handlers = {}) {
   });
 }
 
+function getVectorTypedArrayDescriptor(structure) {
+  const { typedArray, length } = structure;
+  // a vector's storage can be larger than its elements (e.g. @Vector(3, f32) takes 16 bytes),
+  // so the view covers only the elements and assignment goes through the initializer
+  return markAsSpecial({
+    get() {
+      const dv = this.dataView;
+      return new typedArray(dv.buffer, dv.byteOffset, length);
+    },
+    set(ta) {
+      if (!isTypedArray(ta, typedArray)) {
+        throw new TypeMismatch(typedArray.name, ta);
+      }
+      this.$ = ta;
+    },
+  });
+}
+
 function markAsSpecial({ get, set }) {
   get.special = set.special = true;
   return { get, set };
@@ -0,0 +1,133 @@
+import { MEMORY } from './symbol.js';
+
+const sampleCount = 1024;
+const sampledPhases = [ 'total', 'marshalIn', 'native', 'marshalOut' ];
+
+export class CallStatistics {
+  records = new Map();
+  frames = [];
+
+  measure(phase, cb, env, args) {
+    const frame = this.frames[this.frames.length - 1];
+    if (frame) {
+      switch (phase) {
+        // for a callback from Zig, time spent in the JavaScript function takes the place of
+        // native time
+        case 'native':
+        case 'callback': {
+          const start = performance.now();
+          try {
+            return cb();
+          } finally {
+            const end = performance.now();
+            frame.nativeStart ||= start;
+            frame.nativeEnd = end;
+            frame.native += end - start;
+          }
+        }
+        case 'copy-in':
+        case 'copy-out': {
+          const shadowMap = env.context?.shadowMap;
+          if (shadowMap) {
+            for (const [ shadow ] of shadowMap) {
+              frame.bytesCopied += shadow[MEMORY].byteLength;
+            }
+          }
+        } break;
+        case 'copy': {
+          const [ dst, address, len ] = args;
+          frame.bytesCopied += len;
+        } break;
+        case 'shadow': frame.shadows++; break;
+        case 'allocate': frame.allocations++; break;
+      }
+    }
+    return cb();
+  }
+
+  call(thunkId, name, cb) {
+    const frame = {
+      start: performance.now(),
+      nativeStart: 0,
+      nativeEnd: 0,
+      native: 0,
+      bytesCopied: 0,
+      shadows: 0,
+      allocations: 0,
+    };
+    this.frames.push(frame);
+    try {
+      return cb();
+    } finally {
+      this.frames.pop();
+      this.add(thunkId, name, frame, performance.now());
+    }
+  }
+
+  add(thunkId, name, frame, end) {
+    let record = this.records.get(thunkId);
+    if (!record) {
+      record = {
+        name,
+        calls: 0,
+        totalTime: 0,
+        marshalInTime: 0,
+        nativeTime: 0,
+        marshalOutTime: 0,
+        bytesCopied: 0,
+        shadows: 0,
+        allocations: 0,
+        // rings holding the durations of the most recent calls, one for each phase
+        samples: Object.fromEntries(sampledPhases.map(p => [ p, new Float64Array(sampleCount) ])),
+      };
+      this.records.set(thunkId, record);
+    }
+    const { start, nativeStart, nativeEnd, native } = frame;
+    const durations = {
+      total: end - start,
+      marshalIn: (nativeStart || end) - start,
+      native,
+      marshalOut: end - (nativeEnd || end),
+    };
+    const index = record.calls % sampleCount;
+    for (const phase of sampledPhases) {
+      record.samples[phase][index] = durations[phase];
+    }
+    record.calls++;
+    record.totalTime += durations.total;
+    record.marshalInTime += durations.marshalIn;
+    record.nativeTime += durations.native;
+    record.marshalOutTime += durations.marshalOut;
+    record.bytesCopied += frame.bytesCopied;
+    record.shadows += frame.shadows;
+    record.allocations += frame.allocations;
+  }
+
+  report() {
+    const list = [];
+    for (const [ thunkId, record ] of this.records) {
+      const { samples, ...counts } = record;
+      const [ total, ...phases ] = sampledPhases.map(p => getPercentiles(samples[p], record.calls));
+      list.push({
+        ...counts,
+        thunkId,
+        meanTime: record.totalTime / record.calls,
+        ...total,
+        phases: Object.fromEntries(sampledPhases.slice(1).map((p, i) => [ p, phases[i] ])),
+      });
+    }
+    // functions taking up the most time first
+    return list.sort((a, b) => b.totalTime - a.totalTime);
+  }
+
+  reset() {
+    this.records.clear();
+  }
+}
+
+function getPercentiles(samples, calls) {
+  // percentiles are based on the most recent calls only
+  const sorted = samples.slice(0, Math.min(calls, sampleCount)).sort();
+  const percentile = (p) => sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+  return { p50: percentile(0.5), p90: percentile(0.9), p99: percentile(0.99) };
+}
@@ -9,8 +9,8 @@ import {
   convertToJSON, getBase64Descriptor, getDataViewDescriptor, getValueOf, handleError
 } from './special.js';
 import {
-  ALIGN, COPIER, ENTRIES_GETTER, MEMORY, PARENT, POINTER_VISITOR, PROPS, SIZE, SLOTS, TUPLE, TYPE,
-  VIVIFICATOR, WRITE_DISABLER
+  ALIGN, COPIER, ENTRIES_GETTER, MEMORY, NEXT_BATCH, PARENT, POINTER_VISITOR, PROPS, SIZE, SLOTS, TUPLE,
+  TYPE, VIVIFICATOR, WRITE_DISABLER
 } from './symbol.js';
 import { MemberType } from './types.js';
 import { getVectorEntries, getVectorIterator } from './vector.js';
@@ -81,6 +81,7 @@ export function defineStructShape(structure, env) {
     entries: isTuple && { value: getVectorEntries },
     ...memberDescriptors,
     [Symbol.iterator]: { value: getIterator },
+    [Symbol.asyncIterator]: isIterator && { value: getAsyncIteratorIterator },
     [Symbol.toPrimitive]: backingInt && { value: toPrimitive },
     [ENTRIES_GETTER]: { value: isTuple ? getVectorEntries : getStructEntries },
     [COPIER]: { value: getMemoryCopier(byteSize) },
@@ -106,6 +107,9 @@ export function getStructEntries(options) {
 }
 
 export function getIteratorIterator() {
+  if (this[NEXT_BATCH]) {
+    return getBatchIterator(this);
+  }
   const self = this;
   return {
     next() {
@@ -116,6 +120,64 @@ export function getIteratorIterator() {
   };
 }
 
+export function getAsyncIteratorIterator() {
+  const iterator = getIteratorIterator.call(this);
+  return {
+    async next() {
+      if (iterator.isEmpty?.()) {
+        // let other tasks run before the next batch is pulled
+        await yieldToEventLoop();
+      }
+      return iterator.next();
+    },
+  };
+}
+
+const maxBatchSize = 1024;
+
+function getBatchIterator(self) {
+  // only iterators that opt into prefetching have NEXT_BATCH, as items are lost when the loop
+  // exits early; start small so that not much is lost, then grow
+  let size = 1;
+  let batch = null;
+  let index = 0, length = 0;
+  let done = false;
+  const fetch = () => {
+    const current = batch;
+    batch = null;
+    index = length = 0;
+    if (current) {
+      done = current.end;
+      // throw the error encountered once the items before it have been consumed
+      current.err;
+    }
+    if (!done) {
+      batch = self[NEXT_BATCH](size);
+      length = batch.len;
+      size = Math.min(size * 2, maxBatchSize);
+    }
+  };
+  return {
+    next() {
+      while (index === length && !done) {
+        fetch();
+      }
+      if (done) {
+        return { value: undefined, done };
+      }
+      const value = batch.items[index++];
+      return { value, done };
+    },
+    isEmpty() {
+      return index === length && !done;
+    },
+  };
+}
+
+function yieldToEventLoop() {
+  return new Promise(r => (typeof(setImmediate) === 'function') ? setImmediate(r) : setTimeout(r, 0));
+}
+
 export function getStructIterator(options) {
   const entries = getStructEntries.call(this, options);
   return entries[Symbol.iterator]();
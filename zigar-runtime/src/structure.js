@@ -3,6 +3,7 @@ import { defineArray } from './array.js';
 import { defineEnumerationShape } from './enumeration.js';
 import { defineErrorSet } from './error-set.js';
 import { defineErrorUnion } from './error-union.js';
+import { defineFunction } from './function.js';
 import { useEnumerationTransform, useErrorSetTransform, useUint } from './member.js';
 import { defineOpaque } from './opaque.js';
 import { defineOptional } from './optional.js';
@@ -109,6 +110,11 @@ export function useOpaque() {
   factories[StructureType.Opaque] = defineOpaque;
 }
 
+export function useFunction() {
+  factories[StructureType.Function] = defineFunction;
+  useUint();
+}
+
 export function getStructureFactory(type) {
   const f = factories[type];
   /* DEV-TEST */
@@ -241,4 +247,5 @@ export function useAllStructureTypes() {
   useSlice();
   useVector();
   useOpaque();
+  useFunction();
 }
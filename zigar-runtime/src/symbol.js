@@ -45,3 +45,7 @@ export const ENVIRONMENT = Symbol('environment');
 export const ATTRIBUTES = Symbol('attributes');
 export const MORE = Symbol('more');
 export const PRIMITIVE = Symbol('primitive');
+export const NEXT_BATCH = Symbol('nextBatch');
+export const CALLBACK_BINDER = Symbol('callbackBinder');
+export const CALLBACK_UNBINDER = Symbol('callbackUnbinder');
+export const PACKED = Symbol('packed');
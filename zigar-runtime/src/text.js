@@ -32,6 +32,14 @@ export function decodeText(arrays, encoding = 'utf-8') {
 export function encodeText(text, encoding = 'utf-8') {
   switch (encoding) {
     case 'utf-16': {
+      /* NODE-ONLY */
+      if (typeof(Buffer) === 'function' && Buffer.prototype instanceof Uint8Array) {
+        // avoid the shared pool so the array gets a buffer of its own
+        const b = Buffer.allocUnsafeSlow(text.length * 2);
+        b.write(text, 'utf16le');
+        return new Uint16Array(b.buffer, b.byteOffset, text.length);
+      }
+      /* NODE-ONLY-END */
       const { length } = text;
       const ta = new Uint16Array(length);
       for (let i = 0; i < length; i++) {
@@ -49,6 +57,39 @@ export function encodeText(text, encoding = 'utf-8') {
   }
 }
 
+export function encodeTextList(texts) {
+  // encode a list of strings into a single array, returning it along with where each string ends
+  let encoder = encoders['utf-8'];
+  if (!encoder) {
+    encoder = encoders['utf-8'] = new TextEncoder();
+  }
+  let remaining = 0;
+  for (const text of texts) {
+    remaining += text.length;
+  }
+  // enough room when everything is ASCII
+  let array = new Uint8Array(remaining);
+  let offset = 0;
+  const ends = new Array(texts.length);
+  for (let i = 0; i < texts.length; i++) {
+    let text = texts[i];
+    let { read, written } = encoder.encodeInto(text, array.subarray(offset));
+    offset += written;
+    if (read < text.length) {
+      // make sure the rest of this string would fit, at up to 3 bytes per UTF-16 code unit
+      text = text.slice(read);
+      const newArray = new Uint8Array(offset + text.length * 3 + remaining - texts[i].length);
+      newArray.set(array.subarray(0, offset));
+      array = newArray;
+      ({ written } = encoder.encodeInto(text, array.subarray(offset)));
+      offset += written;
+    }
+    remaining -= texts[i].length;
+    ends[i] = offset;
+  }
+  return { array: array.subarray(0, offset), ends };
+}
+
 export function encodeBase64(dv) {
   /* NODE-ONLY */
   if (typeof(Buffer) === 'function' && Buffer.prototype instanceof Uint8Array) {
@@ -0,0 +1,41 @@
+// phases that get their own spans
+const spanPhases = [
+  'arguments', 'pointers', 'copy-in', 'native', 'copy-out', 'targets', 'console', 'allocate', 'free',
+  'copy', 'callback',
+];
+
+export class CallTracer {
+  names = [];
+
+  call(thunkId, name, cb) {
+    this.names.push(name);
+    const start = performance.now();
+    try {
+      return cb();
+    } finally {
+      this.names.pop();
+      emitSpan(name, start, { thunkId });
+    }
+  }
+
+  measure(phase, cb, env, args) {
+    const name = this.names[this.names.length - 1];
+    if (!name || !spanPhases.includes(phase)) {
+      return cb();
+    }
+    const start = performance.now();
+    try {
+      return cb();
+    } finally {
+      emitSpan(`${name}:${phase}`, start, { phase });
+    }
+  }
+}
+
+function emitSpan(name, start, detail) {
+  // measures show up in Chrome tracing, in Node's trace events (node.perf.usertiming), and in
+  // performance observers; they're removed from the timeline right away so it doesn't keep
+  // growing for as long as tracing is on
+  performance.measure(name, { start, end: performance.now(), detail });
+  performance.clearMeasures(name);
+}
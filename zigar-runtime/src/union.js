@@ -10,7 +10,9 @@ import { copyPointer, disablePointer, never, resetPointer } from './pointer.js';
 import {
   convertToJSON, getBase64Descriptor, getDataViewDescriptor, getValueOf, handleError
 } from './special.js';
-import { getChildVivificator, getIteratorIterator, getPointerVisitor } from './struct.js';
+import {
+  getAsyncIteratorIterator, getChildVivificator, getIteratorIterator, getPointerVisitor
+} from './struct.js';
 import {
   ALIGN, COPIER, ENTRIES_GETTER, NAME, POINTER_VISITOR, PROPS, PROP_GETTERS, PROP_SETTERS, SIZE,
   TAG, TYPE, VIVIFICATOR, WRITE_DISABLER
@@ -171,6 +173,7 @@ export function defineUnionShape(structure, env) {
     delete: { value: getDestructor(env) },
     ...memberDescriptors,
     [Symbol.iterator]: { value: getIterator },
+    [Symbol.asyncIterator]: isIterator && { value: getAsyncIteratorIterator },
     [Symbol.toPrimitive]: isTagged && { value: toPrimitive },
     [ENTRIES_GETTER]: { value: getUnionEntries },
     [COPIER]: { value: getMemoryCopier(byteSize) },
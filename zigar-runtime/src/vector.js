@@ -1,4 +1,5 @@
-import { getCompatibleTags, getTypedArrayClass } from './data-view.js';
+import { getBulkArrayClass } from './array.js';
+import { getCompatibleTags, getTypedArrayClass, isTypedArray } from './data-view.js';
 import { ArrayLengthMismatch, InvalidArrayInitializer } from './error.js';
 import { getDescriptor } from './member.js';
 import { getDestructor, getMemoryCopier } from './memory.js';
@@ -9,7 +10,7 @@ import {
   convertToJSON, getBase64Descriptor, getDataViewDescriptor, getTypedArrayDescriptor, getValueOf
 } from './special.js';
 import {
-  ALIGN, COMPAT, COPIER, ENTRIES_GETTER, PROP_SETTERS, SIZE, TYPE, WRITE_DISABLER
+  ALIGN, COMPAT, COPIER, ENTRIES_GETTER, MEMORY, PROP_SETTERS, SIZE, TYPE, WRITE_DISABLER
 } from './symbol.js';
 
 export function defineVector(structure, env) {
@@ -35,9 +36,14 @@ export function defineVector(structure, env) {
     elementDescriptors[i] = { get, set, configurable: true };
   }
   const propApplier = createPropertyApplier(structure);
+  const bulkArray = getBulkArrayClass(structure, env);
   const initializer = function(arg) {
     if (arg instanceof constructor) {
       this[COPIER](arg);
+    } else if (isTypedArray(arg, bulkArray) && arg.length === length) {
+      // copy all elements at once
+      const dv = this[MEMORY];
+      new bulkArray(dv.buffer, dv.byteOffset, length).set(arg);
     } else if (arg?.[Symbol.iterator]) {
       let argLen = arg.length;
       if (typeof(argLen) !== 'number') {
@@ -1107,6 +1107,151 @@ describe('Array functions', function() {
       delete object[Symbol.asyncIterator];
       expect(object[Symbol.asyncIterator]).to.be.undefined;
     })
+    it('should copy numbers in bulk using getRange, setRange, and fill', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Array,
+        name: 'Hello',
+        length: 8,
+        byteSize: 4 * 8,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Int,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Int32Array }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object = new Hello([ 1, 2, 3, 4, 5, 6, 7, 8 ]);
+      expect(object.getRange(2, 5)).to.eql(new Int32Array([ 3, 4, 5 ]));
+      expect(object.getRange(-2)).to.eql(new Int32Array([ 7, 8 ]));
+      const out = new Int32Array(3);
+      expect(object.getRange(0, 3, out)).to.equal(out);
+      expect(out).to.eql(new Int32Array([ 1, 2, 3 ]));
+      expect(() => object.getRange(0, 3, new Uint32Array(3))).to.throw(TypeError);
+      object.setRange(1, new Int32Array([ -1, -2 ]));
+      object.setRange(3, [ -3 ]);
+      object.fill(9, 6);
+      expect([ ...object ]).to.eql([ 1, -1, -2, -3, 5, 6, 9, 9 ]);
+      expect(() => object.setRange(7, [ 1, 2 ])).to.throw(RangeError);
+      expect(() => object.setRange(0, [ 2 ** 32 ])).to.throw(TypeError);
+      expect(() => object.fill(2 ** 32)).to.throw(TypeError);
+    })
+    it('should fill array of non-numeric elements', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Array,
+        name: 'Hello',
+        length: 4,
+        byteSize: 4,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Bool,
+        bitSize: 1,
+        byteSize: 1,
+        structure: { constructor: function() {} }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object = new Hello([ false, false, false, false ]);
+      object.fill(true, 1, 3);
+      expect([ ...object ]).to.eql([ false, true, true, false ]);
+      expect(object.getRange(1)).to.eql([ true, true, false ]);
+    })
+    it('should initialize array from matching typed array and array of numbers in bulk', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Array,
+        name: 'Hello',
+        length: 4,
+        byteSize: 8 * 4,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Float,
+        bitSize: 64,
+        byteSize: 8,
+        structure: { constructor: function() {}, typedArray: Float64Array }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object1 = new Hello(new Float64Array([ 1.5, 2.5, 3.5, 4.5 ]));
+      expect([ ...object1 ]).to.eql([ 1.5, 2.5, 3.5, 4.5 ]);
+      const object2 = new Hello([ 0.5, 1, 2, 3 ]);
+      expect(object2.typedArray).to.eql(new Float64Array([ 0.5, 1, 2, 3 ]));
+    })
+    it('should not create proxy when array proxy is disabled', function() {
+      const env = new NodeEnvironment();
+      env.arrayProxy = false;
+      const structure = env.beginStructure({
+        type: StructureType.Array,
+        name: 'Hello',
+        length: 4,
+        byteSize: 4 * 4,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Uint,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Uint32Array }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object = new Hello([ 1, 2, 3, 4 ]);
+      expect(object.$).to.equal(object);
+      expect(object[0]).to.be.undefined;
+      expect(object.get(3)).to.equal(4);
+      expect([ ...object ]).to.eql([ 1, 2, 3, 4 ]);
+    })
+    it('should provide a flat typed array for an array of vectors', function() {
+      const vectorStructure = env.beginStructure({
+        type: StructureType.Vector,
+        name: '@Vector(4, f32)',
+        length: 4,
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(vectorStructure, {
+        type: MemberType.Float,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Float32Array },
+      });
+      env.finalizeShape(vectorStructure);
+      env.finalizeStructure(vectorStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Array,
+        name: '[2]@Vector(4, f32)',
+        length: 2,
+        byteSize: 32,
+        align: 16,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        byteSize: 16,
+        structure: vectorStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object = new Hello(new Float32Array([ 1, 2, 3, 4, 5, 6, 7, 8 ]));
+      expect([ ...object[1] ]).to.eql([ 5, 6, 7, 8 ]);
+      const ta = object.typedArray;
+      expect(ta).to.be.an.instanceOf(Float32Array);
+      expect(ta).to.have.lengthOf(8);
+      ta[0] = 10;
+      expect(object[0][0]).to.equal(10);
+      object.$ = new Float32Array([ 8, 7, 6, 5, 4, 3, 2, 1 ]);
+      expect([ ...object[0] ]).to.eql([ 8, 7, 6, 5 ]);
+      expect(() => object.$ = new Float32Array(4)).to.throw(TypeError);
+      // cast without copying
+      const flat = new Float32Array(8);
+      const cast = Hello(flat);
+      cast[1][3] = 123;
+      expect(flat[7]).to.equal(123);
+    })
   })
   describe('makeArrayReadOnly', function() {
     it('should make an array read-only', function() {
@@ -1132,6 +1277,8 @@ describe('Array functions', function() {
       object[WRITE_DISABLER]();
       expect(() => object[0] = 0).to.throw(TypeError);
       expect(() => object.set(0, 5)).to.throw(TypeError);
+      expect(() => object.setRange(0, [ 5 ])).to.throw(TypeError);
+      expect(() => object.fill(5)).to.throw(TypeError);
     })
     it('should make child objects read-only as well', function() {
       const structStructure = env.beginStructure({
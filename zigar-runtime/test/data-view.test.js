@@ -929,6 +929,48 @@ describe('Data view functions', function() {
         }
       }
     })
+    it('should handle non-aligned fields at the end of the buffer', function() {
+      // struct { a: u3, b: u21 } is only 3 bytes long, too short for a 32-bit load
+      const dv = new DataView(new ArrayBuffer(3));
+      const member = { type: MemberType.Uint, bitSize: 21, bitOffset: 3 };
+      const get = getNumericAccessor('get', member);
+      const set = getNumericAccessor('set', member);
+      dv.setUint8(0, 0x07);
+      set.call(dv, 0, 0x1F_FFFF >> 1, true);
+      expect(get.call(dv, 0, true)).to.equal(0x1F_FFFF >> 1);
+      expect(dv.getUint8(0) & 0x07).to.equal(0x07);
+      const int = { type: MemberType.Int, bitSize: 37, bitOffset: 20 };
+      const dv2 = new DataView(new ArrayBuffer(8));
+      const getInt = getNumericAccessor('get', int);
+      const setInt = getNumericAccessor('set', int);
+      setInt.call(dv2, 2, -12345678901n, true);
+      expect(getInt.call(dv2, 2, true)).to.equal(-12345678901n);
+    })
+    it('should read non-aligned fields the same way regardless of word size used', function() {
+      const dv = new DataView(new ArrayBuffer(16));
+      for (let i = 0; i < 16; i++) {
+        dv.setUint8(i, (i * 0x9E + 0x37) & 0xFF);
+      }
+      for (const type of [ MemberType.Int, MemberType.Uint ]) {
+        for (const bitSize of [ 5, 11, 19, 27, 33, 50 ]) {
+          for (let bitOffset = 1; bitOffset <= 7; bitOffset++) {
+            const member = { type, bitSize, bitOffset };
+            const get = getNumericAccessor('get', member);
+            // compute expected value from individual bits
+            let n = 0n;
+            for (let i = bitSize - 1; i >= 0; i--) {
+              const pos = bitOffset + i;
+              n = (n << 1n) | BigInt((dv.getUint8(pos >> 3) >> (pos & 7)) & 1);
+            }
+            if (type === MemberType.Int) {
+              n = BigInt.asIntN(bitSize, n);
+            }
+            const expected = (bitSize > 32) ? n : Number(n);
+            expect(get.call(dv, 0, true)).to.equal(expected);
+          }
+        }
+      }
+    })
     it('should return functions for getting standard float types', function() {
       const dv = new DataView(new ArrayBuffer(16));
       dv.setFloat32(0, 3.14, true);
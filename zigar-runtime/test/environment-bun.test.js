@@ -0,0 +1,179 @@
+import { expect } from 'chai';
+
+describe('BunEnvironment', function() {
+  // bun:ffi is only available in Bun
+  let BunEnvironment, ptr;
+  before(async function() {
+    if (!process.versions.bun) {
+      this.skip();
+    }
+    ({ BunEnvironment } = await import('../src/environment-bun.js'));
+    ({ ptr } = await import('bun:ffi'));
+  })
+  describe('getBufferAddress', function() {
+    it('should return address of buffer', function() {
+      const env = new BunEnvironment();
+      const buffer = new ArrayBuffer(16);
+      const address = env.getBufferAddress(buffer);
+      expect(address).to.be.a('bigint');
+      expect(address).to.equal(BigInt(ptr(buffer)));
+    })
+    it('should return zero for empty buffer', function() {
+      const env = new BunEnvironment();
+      expect(env.getBufferAddress(new ArrayBuffer(0))).to.equal(0n);
+    })
+  })
+  describe('obtainExternBuffer', function() {
+    it('should return buffer of memory at address', function() {
+      const env = new BunEnvironment();
+      const array = new Uint8Array([ 1, 2, 3, 4 ]);
+      const buffer = env.obtainExternBuffer(BigInt(ptr(array)), 4);
+      expect(buffer).to.be.an.instanceOf(ArrayBuffer);
+      expect([ ...new Uint8Array(buffer) ]).to.eql([ 1, 2, 3, 4 ]);
+    })
+  })
+  describe('copyBytes', function() {
+    it('should copy bytes from address', function() {
+      const env = new BunEnvironment();
+      const array = new Uint8Array([ 1, 2, 3, 4, 5, 6, 7, 8 ]);
+      const dv = new DataView(new ArrayBuffer(8));
+      env.copyBytes(dv, BigInt(ptr(array)), 8);
+      expect(dv.getUint8(7)).to.equal(8);
+    })
+    it('should throw when length does not match', function() {
+      const env = new BunEnvironment();
+      const array = new Uint8Array(8);
+      const dv = new DataView(new ArrayBuffer(4));
+      expect(() => env.copyBytes(dv, BigInt(ptr(array)), 8)).to.throw();
+    })
+  })
+  describe('findSentinel', function() {
+    it('should find single-byte sentinel', function() {
+      const env = new BunEnvironment();
+      const array = new Uint8Array(16).fill(1);
+      array[11] = 0;
+      const sentinel = new DataView(new ArrayBuffer(1));
+      expect(env.findSentinel(BigInt(ptr(array)), sentinel)).to.equal(11);
+    })
+    it('should find multi-byte sentinel', function() {
+      const env = new BunEnvironment();
+      const array = new Uint32Array(16).fill(0x01010101);
+      array[5] = 0x7f7f;
+      const sentinel = new DataView(new ArrayBuffer(4));
+      sentinel.setUint32(0, 0x7f7f, true);
+      expect(env.findSentinel(BigInt(ptr(array)), sentinel)).to.equal(5);
+    })
+    it('should find sentinel beyond the first page', function() {
+      const env = new BunEnvironment();
+      const array1 = new Uint8Array(16384).fill(1);
+      array1[12345] = 0;
+      const sentinel1 = new DataView(new ArrayBuffer(1));
+      expect(env.findSentinel(BigInt(ptr(array1)), sentinel1)).to.equal(12345);
+      // elements straddle page boundaries when their size doesn't divide the page size
+      const array2 = new Uint8Array(16384).fill(1);
+      array2.set([ 2, 3, 4 ], 3000 * 3);
+      const sentinel2 = new DataView(new Uint8Array([ 2, 3, 4 ]).buffer);
+      expect(env.findSentinel(BigInt(ptr(array2)), sentinel2)).to.equal(3000);
+    })
+    it('should ignore sentinel that is not aligned to element', function() {
+      const env = new BunEnvironment();
+      const array = new Uint8Array(32).fill(1);
+      array.set([ 7, 7 ], 5);
+      array.set([ 7, 7 ], 8);
+      const sentinel = new DataView(new Uint8Array([ 7, 7 ]).buffer);
+      expect(env.findSentinel(BigInt(ptr(array)), sentinel)).to.equal(4);
+    })
+    it('should return undefined when address is zero', function() {
+      const env = new BunEnvironment();
+      const sentinel = new DataView(new ArrayBuffer(1));
+      expect(env.findSentinel(0n, sentinel)).to.be.undefined;
+    })
+  })
+  describe('createString', function() {
+    it('should decode UTF-8 string at address', function() {
+      const env = new BunEnvironment();
+      const array = new TextEncoder().encode('Hello world');
+      expect(env.createString(BigInt(ptr(array)), array.length, 1)).to.equal('Hello world');
+    })
+    it('should decode UTF-16 string at address', function() {
+      const env = new BunEnvironment();
+      const array = new Uint16Array([ ...'Hello' ].map(c => c.charCodeAt(0)));
+      expect(env.createString(BigInt(ptr(array)), array.length, 2)).to.equal('Hello');
+    })
+    it('should return empty string when length is zero', function() {
+      const env = new BunEnvironment();
+      expect(env.createString(0n, 0, 1)).to.equal('');
+    })
+  })
+  describe('encodeString', function() {
+    it('should leave room for terminating zero', function() {
+      const env = new BunEnvironment();
+      const dv = env.encodeString('Hello', 1);
+      expect(dv.byteLength).to.equal(5);
+      expect(dv.buffer.byteLength).to.equal(6);
+      expect(new Uint8Array(dv.buffer)[5]).to.equal(0);
+    })
+    it('should throw when given a non-string', function() {
+      const env = new BunEnvironment();
+      expect(() => env.encodeString(1234, 1)).to.throw(TypeError);
+    })
+  })
+  describe('getObjectIndex', function() {
+    it('should give the same index to the same object', function() {
+      const env = new BunEnvironment();
+      const object1 = {}, object2 = {};
+      const index1 = env.getObjectIndex(object1);
+      const index2 = env.getObjectIndex(object2);
+      expect(index1).to.not.equal(index2);
+      expect(env.getObjectIndex(object1)).to.equal(index1);
+      expect(env.getObject(index1)).to.equal(object1);
+      expect(env.getObject(index2)).to.equal(object2);
+    })
+    it('should return zero for null', function() {
+      const env = new BunEnvironment();
+      expect(env.getObjectIndex(null)).to.equal(0);
+      expect(env.getObject(0)).to.be.null;
+      expect(env.getObject(null)).to.be.null;
+    })
+  })
+  describe('leaveCall', function() {
+    it('should clear value table when outermost call ends', function() {
+      const env = new BunEnvironment();
+      env.enterCall();
+      env.enterCall();
+      const index = env.getObjectIndex({});
+      env.leaveCall();
+      expect(env.getObject(index)).to.be.an('object');
+      env.leaveCall();
+      expect(env.getObject(index)).to.be.null;
+    })
+  })
+  describe('getMemoryOffset', function() {
+    it('should return offset from base address', function() {
+      const env = new BunEnvironment();
+      env.baseAddress = 0x10000;
+      expect(env.getMemoryOffset(0x10100n)).to.equal(0x100);
+      expect(env.getMemoryOffset(0x100n)).to.equal(0);
+      expect(env.recreateAddress(0x100)).to.equal(0x10100n);
+    })
+  })
+  describe('unmapFile', function() {
+    it('should throw, as Bun cannot unmap files', function() {
+      const env = new BunEnvironment();
+      expect(() => env.unmapFile(new ArrayBuffer(16))).to.throw(TypeError)
+        .with.property('message', 'Unsupported');
+    })
+  })
+  describe('createJsCallback', function() {
+    it('should return handle that can be released', function() {
+      const env = new BunEnvironment();
+      const handle = env.createJsCallback(() => {});
+      expect(handle).to.be.a('bigint');
+      env.releaseJsCallback(handle);
+    })
+    it('should throw when given a non-function', function() {
+      const env = new BunEnvironment();
+      expect(() => env.createJsCallback(1234)).to.throw(TypeError);
+    })
+  })
+})
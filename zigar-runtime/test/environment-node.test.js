@@ -3,9 +3,11 @@ import { expect } from 'chai';
 import {
   NodeEnvironment,
 } from '../src/environment-node.js';
+import { InvalidDeallocation } from '../src/error.js';
 import { useAllMemberTypes } from '../src/member.js';
 import { useAllStructureTypes } from '../src/structure.js';
-import { ALIGN, ATTRIBUTES, MEMORY, POINTER_VISITOR, SLOTS } from '../src/symbol.js';
+import { ALIGN, ATTRIBUTES, FIXED, MEMORY, POINTER_VISITOR, SLOTS } from '../src/symbol.js';
+import { MemberType, StructureType } from '../src/types.js';
 
 describe('NodeEnvironment', function() {
   beforeEach(function() {
@@ -118,6 +120,10 @@ describe('NodeEnvironment', function() {
       expect(cluster.misaligned).to.be.false;
       const address2 = env.getTargetAddress(object2, cluster);
       expect(address2).to.equal(0x1010n);
+      // the cluster is registered as a whole
+      expect(env.context.memoryList).to.have.lengthOf(1);
+      expect(env.context.memoryList[0].address).to.equal(0x1008n);
+      expect(env.context.memoryList[0].len).to.equal(30);
     })
     it('should return false when cluster is misaligned', function() {
       const env = new NodeEnvironment();
@@ -146,6 +152,198 @@ describe('NodeEnvironment', function() {
       expect(address2).to.be.undefined;
     })
   })
+  describe('pin', function() {
+    function defineTypes(env) {
+      const intStructure = env.beginStructure({
+        type: StructureType.Primitive,
+        name: 'i32',
+        byteSize: 4,
+        align: 4,
+      });
+      env.attachMember(intStructure, {
+        type: MemberType.Int,
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.finalizeShape(intStructure);
+      env.finalizeStructure(intStructure);
+      const ptrStructure = env.beginStructure({
+        type: StructureType.SinglePointer,
+        name: '*i32',
+        byteSize: 8,
+        hasPointer: true,
+      });
+      env.attachMember(ptrStructure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: intStructure,
+      });
+      env.finalizeShape(ptrStructure);
+      env.finalizeStructure(ptrStructure);
+      const argStructure = env.beginStructure({
+        type: StructureType.ArgStruct,
+        name: 'ArgStruct',
+        byteSize: 8,
+        hasPointer: true,
+      });
+      env.attachMember(argStructure, {
+        name: 'retval',
+        type: MemberType.Void,
+        bitOffset: 0,
+        bitSize: 0,
+        byteSize: 0,
+        structure: {},
+      });
+      env.attachMember(argStructure, {
+        name: '0',
+        type: MemberType.Object,
+        bitOffset: 0,
+        bitSize: 64,
+        byteSize: 8,
+        slot: 0,
+        structure: ptrStructure,
+      });
+      env.finalizeShape(argStructure);
+      env.finalizeStructure(argStructure);
+      return { Int32: intStructure.constructor, ArgStruct: argStructure.constructor, ptrStructure };
+    }
+    it('should use cached address of pinned object', function() {
+      const env = new NodeEnvironment();
+      const { Int32, ArgStruct } = defineTypes(env);
+      let count = 0;
+      env.getBufferAddress = () => {
+        count++;
+        return 0x1000n;
+      };
+      const object = new Int32(123);
+      expect(env.pin(object)).to.equal(object);
+      expect(count).to.equal(1);
+      for (let i = 0; i < 3; i++) {
+        const args = new ArgStruct([ object ]);
+        env.startContext();
+        env.updatePointerAddresses(args);
+        expect(args[MEMORY].getBigUint64(0, true)).to.equal(0x1000n);
+        // nothing is registered with the call context
+        expect(env.context.memoryList).to.have.lengthOf(0);
+        env.endContext();
+      }
+      expect(count).to.equal(1);
+      // pointer can be resolved outside of a call
+      const dv = env.findMemory(0x1000n, 1, 4);
+      expect(dv).to.equal(object[MEMORY]);
+    })
+    it('should update pointers inside pinned object', function() {
+      const env = new NodeEnvironment();
+      const { Int32, ptrStructure } = defineTypes(env);
+      const structStructure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'S',
+        byteSize: 8,
+        align: 8,
+        hasPointer: true,
+      });
+      env.attachMember(structStructure, {
+        name: 'p',
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: ptrStructure,
+      });
+      env.finalizeShape(structStructure);
+      env.finalizeStructure(structStructure);
+      const structPtrStructure = env.beginStructure({
+        type: StructureType.SinglePointer,
+        name: '*S',
+        byteSize: 8,
+        hasPointer: true,
+      });
+      env.attachMember(structPtrStructure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: structStructure,
+      });
+      env.finalizeShape(structPtrStructure);
+      env.finalizeStructure(structPtrStructure);
+      const argStructure = env.beginStructure({
+        type: StructureType.ArgStruct,
+        name: 'ArgStruct',
+        byteSize: 8,
+        hasPointer: true,
+      });
+      env.attachMember(argStructure, {
+        name: 'retval',
+        type: MemberType.Void,
+        bitOffset: 0,
+        bitSize: 0,
+        byteSize: 0,
+        structure: {},
+      });
+      env.attachMember(argStructure, {
+        name: '0',
+        type: MemberType.Object,
+        bitOffset: 0,
+        bitSize: 64,
+        byteSize: 8,
+        slot: 0,
+        structure: structPtrStructure,
+      });
+      env.finalizeShape(argStructure);
+      env.finalizeStructure(argStructure);
+      const { constructor: S } = structStructure;
+      const { constructor: ArgStruct } = argStructure;
+      const number = new Int32(123);
+      const object = new S({ p: number });
+      const addresses = new Map([
+        [ object[MEMORY].buffer, 0x1000n ],
+        [ number[MEMORY].buffer, 0x2000n ],
+      ]);
+      env.getBufferAddress = (buffer) => addresses.get(buffer);
+      env.pin(object);
+      const args = new ArgStruct([ object ]);
+      env.startContext();
+      env.updatePointerAddresses(args);
+      expect(args[MEMORY].getBigUint64(0, true)).to.equal(0x1000n);
+      expect(object[MEMORY].getBigUint64(0, true)).to.equal(0x2000n);
+      // only the unpinned child is registered with the call context
+      expect(env.context.memoryList).to.have.lengthOf(1);
+      env.endContext();
+    })
+    it('should keep object pinned until unpin is called the same number of times', function() {
+      const env = new NodeEnvironment();
+      const { Int32 } = defineTypes(env);
+      env.getBufferAddress = () => 0x1000n;
+      env.obtainExternBuffer = (address, len) => new ArrayBuffer(len);
+      const object = new Int32(123);
+      env.pin(object);
+      env.pin(object);
+      env.unpin(object);
+      expect(env.findMemory(0x1000n, 1, 4)).to.equal(object[MEMORY]);
+      env.unpin(object);
+      expect(env.findMemory(0x1000n, 1, 4)).to.not.equal(object[MEMORY]);
+      expect(env.pinnedList).to.have.lengthOf(0);
+    })
+    it('should throw when memory is misaligned', function() {
+      const env = new NodeEnvironment();
+      const { Int32 } = defineTypes(env);
+      env.getBufferAddress = () => 0x1001n;
+      const object = new Int32(123);
+      expect(() => env.pin(object)).to.throw(TypeError)
+        .with.property('message').that.contains('aligned');
+    })
+    it('should throw when given something other than a Zig object', function() {
+      const env = new NodeEnvironment();
+      expect(() => env.pin({})).to.throw(TypeError);
+    })
+  })
   describe('allocateRelocMemory', function() {
     it('should allocate extra bytes to account for alignment', function() {
       const env = new NodeEnvironment();
@@ -157,6 +355,331 @@ describe('NodeEnvironment', function() {
       expect(dv.buffer.byteLength).to.equal(96);
     })
   })
+  describe('allocateFixedArray', function() {
+    it('should return a Uint8Array backed by fixed memory', function() {
+      const env = new NodeEnvironment();
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      const array = env.allocateFixedArray(64);
+      expect(array).to.be.instanceOf(Uint8Array);
+      expect(array.byteLength).to.equal(64);
+      const dv = env.obtainView(array.buffer, array.byteOffset, array.byteLength);
+      expect(dv[FIXED]).to.have.property('address', 0x1000n);
+    })
+    it('should free memory after buffer has been garbage-collected', async function() {
+      if (!globalThis.gc) {
+        this.skip();
+      }
+      const env = new NodeEnvironment();
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      let freed;
+      env.freeExternMemory = function(type, address, len, align) {
+        freed = { address, len };
+      };
+      env.allocateFixedArray(64, 16, true);
+      for (let i = 0; i < 10 && !freed; i++) {
+        await new Promise(r => setTimeout(r, 10));
+        globalThis.gc();
+      }
+      expect(freed).to.eql({ address: 0x1000n, len: 64 });
+    })
+  })
+  describe('freeFixedArray', function() {
+    it('should free memory of array', function() {
+      const env = new NodeEnvironment();
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      let freed;
+      env.freeExternMemory = function(type, address, len, align) {
+        freed = { address, len };
+      };
+      const array = env.allocateFixedArray(64);
+      env.freeFixedArray(array);
+      expect(freed).to.eql({ address: 0x1000n, len: 64 });
+      freed = null;
+      expect(() => env.freeFixedArray(array)).to.throw(InvalidDeallocation);
+      expect(freed).to.be.null;
+    })
+    it('should throw when array is not the whole allocation', function() {
+      const env = new NodeEnvironment();
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      let freed;
+      env.freeExternMemory = function(type, address, len, align) {
+        freed = { address, len };
+      };
+      const array = env.allocateFixedArray(64);
+      expect(() => env.freeFixedArray(array.subarray(8))).to.throw(InvalidDeallocation);
+      expect(() => env.freeFixedArray(new Uint8Array(64))).to.throw(InvalidDeallocation);
+      expect(freed).to.be.undefined;
+      env.freeFixedArray(array);
+      expect(freed).to.eql({ address: 0x1000n, len: 64 });
+    })
+    it('should not free collectable array again after garbage collection', async function() {
+      if (!globalThis.gc) {
+        this.skip();
+      }
+      const env = new NodeEnvironment();
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      let count = 0;
+      env.freeExternMemory = function(type, address, len, align) {
+        count++;
+      };
+      let array = env.allocateFixedArray(64, 16, true);
+      env.freeFixedArray(array);
+      expect(count).to.equal(1);
+      array = null;
+      for (let i = 0; i < 10; i++) {
+        await new Promise(r => setTimeout(r, 10));
+        globalThis.gc();
+      }
+      expect(count).to.equal(1);
+    })
+  })
+  describe('obtainExternView', function() {
+    it('should return views of the same buffer for addresses within a region', function() {
+      const env = new NodeEnvironment();
+      const requests = [];
+      env.obtainExternBuffer = function(address, len) {
+        requests.push({ address, len });
+        return new ArrayBuffer(len);
+      };
+      const dv1 = env.obtainFixedView(0x1000n, 256);
+      const dv2 = env.obtainFixedView(0x1010n, 16);
+      const dv3 = env.obtainFixedView(0x1010n, 16);
+      expect(dv2.buffer).to.equal(dv1.buffer);
+      expect(dv2.byteOffset).to.equal(16);
+      expect(dv2[FIXED]).to.eql({ address: 0x1010n, len: 16 });
+      expect(dv3.buffer).to.equal(dv1.buffer);
+      // views within the region are not cached
+      expect(env.viewMap.get(dv1.buffer)).to.equal(dv1);
+      const dv4 = env.obtainFixedView(0x10f8n, 16);
+      expect(dv4.buffer).to.not.equal(dv1.buffer);
+      expect(requests).to.eql([ { address: 0x1000n, len: 256 }, { address: 0x10f8n, len: 16 } ]);
+    })
+    it('should replace regions that fall within a new one', function() {
+      const env = new NodeEnvironment();
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      env.obtainFixedView(0x1010n, 16);
+      env.obtainFixedView(0x1000n, 16);
+      env.obtainFixedView(0x1030n, 64);
+      env.obtainFixedView(0x1000n, 64);
+      expect(env.fixedRegions.map(r => [ r.address, r.len ])).to.eql([ [ 0x1000n, 64 ], [ 0x1030n, 64 ] ]);
+      const dv = env.obtainFixedView(0x1040n, 16);
+      expect(dv.byteOffset).to.equal(16);
+    })
+    it('should give newly allocated memory a buffer of its own', function() {
+      const env = new NodeEnvironment();
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1040n;
+      };
+      let freed;
+      env.freeExternMemory = function(type, address, len, align) {
+        freed = address;
+      };
+      const region = env.obtainFixedView(0x1000n, 256);
+      const dv = env.allocateFixedMemory(16, 8);
+      expect(dv.buffer).to.not.equal(region.buffer);
+      expect(env.obtainFixedView(0x1040n, 4).buffer).to.equal(dv.buffer);
+      env.releaseFixedView(dv);
+      expect(freed).to.equal(0x1040n);
+      expect(env.obtainFixedView(0x1040n, 4).buffer).to.equal(region.buffer);
+    })
+    it('should not reuse buffers when they are copies', function() {
+      const env = new NodeEnvironment();
+      env.externalBuffers = false;
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      const dv1 = env.obtainFixedView(0x1000n, 256);
+      const dv2 = env.obtainFixedView(0x1010n, 16);
+      expect(dv2.buffer).to.not.equal(dv1.buffer);
+    })
+    it('should drop region once buffer has been garbage-collected', async function() {
+      if (!globalThis.gc) {
+        this.skip();
+      }
+      const env = new NodeEnvironment();
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      env.obtainFixedView(0x1000n, 256);
+      expect(env.fixedRegions).to.have.lengthOf(1);
+      for (let i = 0; i < 10 && env.fixedRegions.length > 0; i++) {
+        await new Promise(r => setTimeout(r, 10));
+        globalThis.gc();
+      }
+      expect(env.fixedRegions).to.have.lengthOf(0);
+    })
+    it('should drop the right region when regions share an address', async function() {
+      if (!globalThis.gc) {
+        this.skip();
+      }
+      const env = new NodeEnvironment();
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      env.allocateExternMemory = function(type, len, align) {
+        return 0x1000n;
+      };
+      env.obtainFixedView(0x1000n, 256);
+      const dv = env.allocateFixedMemory(16, 8);
+      expect(env.fixedRegions).to.have.lengthOf(2);
+      for (let i = 0; i < 10 && env.fixedRegions.length > 1; i++) {
+        await new Promise(r => setTimeout(r, 10));
+        globalThis.gc();
+      }
+      expect(env.fixedRegions).to.have.lengthOf(1);
+      expect(env.fixedRegions[0].ref.deref()).to.equal(dv.buffer);
+    })
+  })
+  describe('obtainMappedView', function() {
+    it('should return a Uint8Array backed by fixed memory', function() {
+      const env = new NodeEnvironment();
+      let args;
+      env.mapFile = function(...a) {
+        args = a;
+        return new ArrayBuffer(64);
+      };
+      env.getBufferAddress = function(buffer) {
+        return 0x1000n;
+      };
+      const array = env.obtainMappedView('/tmp/hello.txt', { access: 'sequential' });
+      expect(array).to.be.instanceOf(Uint8Array);
+      expect(array.byteLength).to.equal(64);
+      expect(args).to.eql([ '/tmp/hello.txt', false, 1 ]);
+      const dv = env.obtainView(array.buffer, 16, 8);
+      expect(dv[FIXED]).to.eql({ address: 0x1010n, len: 8 });
+      env.obtainMappedView('/tmp/hello.txt', { readonly: false });
+      expect(args).to.eql([ '/tmp/hello.txt', true, 0 ]);
+    })
+    it('should not attempt to obtain address of empty buffer', function() {
+      const env = new NodeEnvironment();
+      env.mapFile = function() {
+        return new ArrayBuffer(0);
+      };
+      env.getBufferAddress = function(buffer) {
+        throw new Error('Doh!');
+      };
+      const array = env.obtainMappedView('/tmp/empty.txt');
+      expect(array.byteLength).to.equal(0);
+    })
+    it('should throw when access hint is invalid', function() {
+      const env = new NodeEnvironment();
+      env.mapFile = function() {
+        return new ArrayBuffer(64);
+      };
+      expect(() => env.obtainMappedView('/tmp/hello.txt', { access: 'often' })).to.throw(TypeError)
+        .with.property('message').that.contains('sequential');
+    })
+  })
+  describe('releaseMappedView', function() {
+    it('should unmap buffer of array', function() {
+      const env = new NodeEnvironment();
+      env.mapFile = function() {
+        return new ArrayBuffer(64);
+      };
+      env.getBufferAddress = function(buffer) {
+        return 0x1000n;
+      };
+      let unmapped;
+      env.unmapFile = function(buffer) {
+        unmapped = buffer;
+      };
+      const array = env.obtainMappedView('/tmp/hello.txt');
+      expect(env.fixedRegions).to.have.lengthOf(1);
+      env.releaseMappedView(array);
+      expect(unmapped).to.equal(array.buffer);
+      expect(env.fixedRegions).to.have.lengthOf(0);
+      expect(() => env.releaseMappedView({})).to.throw(TypeError);
+    })
+    it('should keep region when buffer cannot be unmapped', function() {
+      const env = new NodeEnvironment();
+      env.mapFile = function() {
+        return new ArrayBuffer(64);
+      };
+      env.getBufferAddress = function(buffer) {
+        return 0x1000n;
+      };
+      env.unmapFile = function(buffer) {
+        throw new Error('Doh!');
+      };
+      const array = env.obtainMappedView('/tmp/hello.txt');
+      expect(() => env.releaseMappedView(array)).to.throw();
+      expect(env.fixedRegions).to.have.lengthOf(1);
+    })
+  })
+  describe('adviseAccess', function() {
+    it('should pass address and length of array to addon', function() {
+      const env = new NodeEnvironment();
+      env.mapFile = function() {
+        return new ArrayBuffer(64);
+      };
+      env.getBufferAddress = function(buffer) {
+        return 0x1000n;
+      };
+      let args;
+      env.adviseMemory = function(...a) {
+        args = a;
+      };
+      const array = env.obtainMappedView('/tmp/hello.txt');
+      env.adviseAccess(array.subarray(32), 'willneed');
+      expect(args).to.eql([ array.buffer, 32, 32, 3 ]);
+      args = null;
+      env.adviseAccess(new Uint8Array(0), 'random');
+      expect(args).to.be.null;
+      expect(() => env.adviseAccess({}, 'random')).to.throw(TypeError);
+    })
+  })
+  describe('getSpecialExports', function() {
+    it('should include functions for allocating fixed memory', function() {
+      const env = new NodeEnvironment();
+      const specials = env.getSpecialExports();
+      expect(specials.allocateFixed).to.be.a('function');
+      expect(specials.freeFixed).to.be.a('function');
+      expect(specials.mapFile).to.be.a('function');
+      expect(specials.unmapFile).to.be.a('function');
+      expect(specials.advise).to.be.a('function');
+      expect(specials.abandon).to.be.a('function');
+    })
+    it('should include functions for controlling the thread pool', function() {
+      const env = new NodeEnvironment();
+      let count;
+      env.setThreadCount = (n) => count = n;
+      env.getThreadPoolStats = () => ({ threads: count });
+      const specials = env.getSpecialExports();
+      specials.setThreadCount(4);
+      expect(count).to.equal(4);
+      expect(specials.threadPoolStats()).to.eql({ threads: 4 });
+    })
+  })
   describe('invokeThunk', function() {
     it('should invoke the given thunk with the expected arguments', function() {
       const env = new NodeEnvironment();
@@ -17,7 +17,8 @@ import {
   ADDRESS_SETTER, ALIGN,
   COPIER, ENVIRONMENT, FIXED,
   LENGTH,
-  LENGTH_SETTER, MEMORY, MEMORY_RESTORER, POINTER_VISITOR, SLOTS, TARGET_GETTER, WRITE_DISABLER
+  LENGTH_SETTER, MEMORY, MEMORY_RESTORER, PACKED, POINTER_VISITOR, SLOTS, TARGET_GETTER,
+  WRITE_DISABLER
 } from '../src/symbol.js';
 import { MemberType, StructureType } from '../src/types.js';
 
@@ -331,6 +332,18 @@ describe('Environment', function() {
       const address = env.getViewAddress(dv);
       expect(address).to.equal(0x1008n);
     })
+    it('should pass view of shared buffer to getBufferAddress', function() {
+      const env = new Environment();
+      let arg;
+      env.getBufferAddress = (a) => {
+        arg = a;
+        return 0x1000n;
+      };
+      const dv = new DataView(new SharedArrayBuffer(32), 8, 8);
+      const address = env.getViewAddress(dv);
+      expect(address).to.equal(0x1008n);
+      expect(arg).to.equal(dv);
+    })
   })
   describe('obtainView', function() {
     it('should obtain the same view object for the same offset and length', function() {
@@ -1087,6 +1100,100 @@ describe('Environment', function() {
       expect(argStruct[MEMORY].byteLength).to.equal(0);
       expect(env.variables).to.have.lengthOf(2);
     })
+    it('should define classes only when they are accessed', function() {
+      const env = new Environment();
+      env.recreateAddress = function(address) {
+        return address + 0x1000;
+      };
+      env.obtainFixedView = function(address, len) {
+        const dv = new DataView(new ArrayBuffer(len));
+        dv[FIXED] = { address, len };
+        return dv;
+      };
+      const s1 = {
+        type: StructureType.Primitive,
+        name: 'i32',
+        byteSize: 4,
+        align: 4,
+        hasPointer: false,
+        instance: {
+          members: [
+            {
+              type: MemberType.Int,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+            }
+          ],
+          methods: [],
+          template: null,
+        },
+        static: {
+          members: [],
+          methods: [],
+          template: null,
+        },
+      };
+      const s2 = {
+        type: StructureType.Struct,
+        name: 'Hello',
+        byteSize: 4,
+        align: 4,
+        hasPointer: false,
+        instance: {
+          members: [
+            {
+              name: 'dog',
+              type: MemberType.Int,
+              bitOffset: 0,
+              bitSize: 32,
+              byteSize: 4,
+              structure: s1,
+            },
+          ],
+          methods: [],
+          template: null,
+        },
+        static: {
+          members: [
+            {
+              name: 'number',
+              type: MemberType.Object,
+              slot: 0,
+              structure: s1,
+            },
+          ],
+          methods: [],
+          template: {
+            slots: {
+              0: {
+                memory: (() => {
+                  const array = new Uint8Array(4);
+                  const dv = new DataView(array.buffer);
+                  dv.setInt32(0, 1234, true);
+                  return { array };
+                })(),
+                structure: s1,
+                reloc: 0x2000,
+              },
+            },
+          },
+        },
+      };
+      env.recreateStructures([ s1, s2 ]);
+      expect(Object.getOwnPropertyDescriptor(s2, 'constructor').get).to.be.a('function');
+      expect(Object.getOwnPropertyDescriptor(s1, 'constructor').get).to.be.a('function');
+      expect(env.variables).to.have.lengthOf(0);
+      env.linkVariables(false);
+      const { constructor: Hello } = s2;
+      expect(Hello).to.be.a('function');
+      expect(Object.getOwnPropertyDescriptor(s2, 'constructor').value).to.equal(Hello);
+      // variable created after linkage should be linked immediately
+      expect(env.variables).to.have.lengthOf(1);
+      const { object } = env.variables[0];
+      expect(object).to.be.an.instanceOf(s1.constructor);
+      expect(object[MEMORY][FIXED]).to.eql({ address: 0x3000, len: 4 });
+    })
   })
   describe('linkVariables', function() {
     it('should link variables', function() {
@@ -1310,6 +1417,45 @@ describe('Environment', function() {
       expect(() => env.runThunk()).to.throw();
     })
   })
+  describe('setThreadCount', function() {
+    it('should throw', function() {
+      const env = new Environment();
+      expect(() => env.setThreadCount(4)).to.throw(TypeError);
+      expect(env.getThreadPoolStats()).to.be.null;
+    })
+  })
+  describe('getStartupProfile', function() {
+    it('should return null when module was loaded without profiling', function() {
+      const env = new Environment();
+      env.linkVariables(false);
+      expect(env.getStartupProfile()).to.be.null;
+    })
+    it('should combine times from addon with those of JavaScript phases', function() {
+      const env = new Environment();
+      env.getLoadProfile = () => ({ dlopen: 1.5, dlsym: 0.1, dladdr: 0.1, redirect: null, patch: 0.2 });
+      env.linkVariables(false);
+      const profile = env.getStartupProfile();
+      expect(profile).to.include({ dlopen: 1.5, redirect: null });
+      expect(profile.variables).to.be.a('number');
+      const { startupProfile } = env.getSpecialExports();
+      expect(startupProfile()).to.eql(profile);
+    })
+  })
+  describe('pin', function() {
+    it('should accept object in fixed memory', function() {
+      const env = new Environment();
+      const dv = new DataView(new ArrayBuffer(4));
+      dv[FIXED] = { address: 0x1000n, len: 4 };
+      const object = { [MEMORY]: dv };
+      expect(env.pin(object)).to.equal(object);
+      expect(() => env.unpin(object)).to.not.throw();
+    })
+    it('should throw when object is in relocatable memory', function() {
+      const env = new Environment();
+      const object = { [MEMORY]: new DataView(new ArrayBuffer(4)) };
+      expect(() => env.pin(object)).to.throw(TypeError);
+    })
+  })
   describe('getSpecialExports', function() {
     it('should return object for controlling module', async function() {
       const env = new Environment();
@@ -1881,6 +2027,24 @@ describe('Environment', function() {
       expect(clusters[0].start).to.equal(0);
       expect(clusters[0].end).to.equal(12);
     })
+    it('should place all objects in a packed buffer into one cluster', function() {
+      const env = new Environment();
+      const Test = function(dv) {
+        this[MEMORY] = dv;
+      };
+      const buffer = new ArrayBuffer(16);
+      buffer[PACKED] = true;
+      const object1 = new Test(new DataView(buffer, 0, 5));
+      const object2 = new Test(new DataView(buffer, 5, 3));
+      const object3 = new Test(new DataView(buffer, 10, 6));
+      const clusters = env.findTargetClusters([
+        [ object1, object2, object3 ],
+      ]);
+      expect(clusters).to.have.lengthOf(1);
+      expect(clusters[0].targets).to.eql([ object1, object2, object3 ]);
+      expect(clusters[0].start).to.equal(0);
+      expect(clusters[0].end).to.equal(16);
+    })
   })
   describe('getShadowAddress', function() {
     it('should create a shadow of an object and return the its address', function() {
@@ -2572,6 +2736,123 @@ describe('Environment', function() {
       expect(pointer.dataView).to.equal(dv);
     })
   })
+  describe('registerTargetRegion', function() {
+    function defineStringList(env) {
+      const u8Structure = env.beginStructure({
+        type: StructureType.Primitive,
+        name: 'u8',
+        byteSize: 1,
+        align: 1,
+      });
+      env.attachMember(u8Structure, {
+        type: MemberType.Uint,
+        bitSize: 8,
+        bitOffset: 0,
+        byteSize: 1,
+      });
+      env.finalizeShape(u8Structure);
+      env.finalizeStructure(u8Structure);
+      const sliceStructure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_]const u8',
+        byteSize: 1,
+        align: 1,
+      });
+      env.attachMember(sliceStructure, {
+        type: MemberType.Uint,
+        bitSize: 8,
+        byteSize: 1,
+        structure: u8Structure,
+      });
+      env.finalizeShape(sliceStructure);
+      env.finalizeStructure(sliceStructure);
+      const ptrStructure = env.beginStructure({
+        type: StructureType.SlicePointer,
+        name: '[]const u8',
+        byteSize: 16,
+        align: 8,
+        isConst: true,
+        hasPointer: true,
+      });
+      env.attachMember(ptrStructure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        bitOffset: 0,
+        byteSize: 16,
+        slot: 0,
+        structure: sliceStructure,
+      });
+      env.finalizeShape(ptrStructure);
+      env.finalizeStructure(ptrStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_][]const u8',
+        byteSize: 16,
+        align: 8,
+        hasPointer: true,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        byteSize: 16,
+        structure: ptrStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      return structure.constructor;
+    }
+    function createList(List, entries) {
+      const dv = new DataView(new ArrayBuffer(entries.length * 16));
+      entries.forEach(([ address, len ], i) => {
+        dv.setBigUint64(i * 16, address, true);
+        dv.setBigUint64(i * 16 + 8, BigInt(len), true);
+      });
+      return List(dv);
+    }
+    it('should register the region that strings in a list occupy', function() {
+      const env = new Environment();
+      const List = defineStringList(env);
+      const list = createList(List, [ [ 0x1000n, 5 ], [ 0x1008n, 3 ], [ 0x1010n, 0 ], [ 0x1005n, 2 ] ]);
+      let count = 0;
+      env.obtainExternView = function(address, len) {
+        count++;
+        const buffer = new ArrayBuffer(len);
+        buffer[FIXED] = { address, len };
+        return env.obtainView(buffer, 0, len);
+      };
+      env.startContext();
+      env.registerTargetRegion(list);
+      expect(env.context.memoryList).to.have.lengthOf(1);
+      expect(env.context.memoryList[0].address).to.equal(0x1000n);
+      expect(env.context.memoryList[0].len).to.equal(11);
+      const dv1 = env.findMemory(0x1000n, 5, 1);
+      const dv2 = env.findMemory(0x1008n, 3, 1);
+      expect(dv1.buffer).to.equal(dv2.buffer);
+      expect(dv2.byteOffset).to.equal(8);
+      expect(dv2[FIXED].address).to.equal(0x1008n);
+      expect(count).to.equal(1);
+    })
+    it('should not register a region when strings are scattered', function() {
+      const env = new Environment();
+      const List = defineStringList(env);
+      const list = createList(List, [ [ 0x1000n, 5 ], [ 0x100000n, 3 ] ]);
+      env.startContext();
+      env.registerTargetRegion(list);
+      expect(env.context.memoryList).to.have.lengthOf(0);
+    })
+    it('should not register a region overlapping memory from JavaScript', function() {
+      const env = new Environment();
+      const List = defineStringList(env);
+      const list = createList(List, [ [ 0x1000n, 5 ], [ 0x1008n, 3 ] ]);
+      env.getBufferAddress = function() {
+        return 0x1004n;
+      };
+      env.startContext();
+      env.registerMemory(new DataView(new ArrayBuffer(4)));
+      env.registerTargetRegion(list);
+      expect(env.context.memoryList).to.have.lengthOf(1);
+    })
+  })
   describe('acquireDefaultPointers', function() {
     it('should acquire targets of pointers in structure template slots', function() {
       const env = new Environment();
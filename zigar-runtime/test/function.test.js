@@ -0,0 +1,203 @@
+import { expect } from 'chai';
+
+import { NodeEnvironment } from '../src/environment-node.js';
+import { useAllMemberTypes } from '../src/member.js';
+import { useAllStructureTypes } from '../src/structure.js';
+import { CALLBACK_BINDER, CALLBACK_UNBINDER, ENVIRONMENT } from '../src/symbol.js';
+import { MemberType, StructureType } from '../src/types.js';
+
+describe('Function functions', function() {
+  describe('defineFunction', function() {
+    beforeEach(function() {
+      useAllMemberTypes();
+      useAllStructureTypes();
+    })
+    function defineCallback(env) {
+      const argStructure = env.beginStructure({
+        type: StructureType.ArgStruct,
+        name: 'Arg0001',
+        byteSize: 8,
+      });
+      env.attachMember(argStructure, {
+        name: 'retval',
+        type: MemberType.Void,
+        bitSize: 0,
+        bitOffset: 0,
+        byteSize: 0,
+      });
+      env.attachMember(argStructure, {
+        name: '0',
+        type: MemberType.Int,
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.attachMember(argStructure, {
+        name: '1',
+        type: MemberType.Bool,
+        bitSize: 1,
+        bitOffset: 32,
+        byteSize: 1,
+      });
+      env.finalizeShape(argStructure);
+      env.finalizeStructure(argStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Function,
+        name: '*const fn (i32, bool) void',
+        byteSize: 8,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: argStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      // stand-ins for the methods exported by Zig
+      const handles = new Map();
+      let nextAddress = 0x1000n;
+      structure.constructor[CALLBACK_BINDER] = (handle) => {
+        const address = nextAddress;
+        nextAddress += 0x10n;
+        handles.set(address, handle);
+        return address;
+      };
+      structure.constructor[CALLBACK_UNBINDER] = (address) => {
+        const handle = handles.get(address);
+        handles.delete(address);
+        return handle ?? 0n;
+      };
+      return { structure, handles };
+    }
+    function createEnvironment() {
+      const env = new NodeEnvironment();
+      const handlers = new Map();
+      let nextHandle = 1n;
+      env.createJsCallback = (handler) => {
+        const handle = nextHandle++;
+        handlers.set(handle, handler);
+        return handle;
+      };
+      env.releaseJsCallback = (handle) => {
+        handlers.delete(handle);
+      };
+      return { env, handlers };
+    }
+    it('should define a function pointer structure', function() {
+      const { env } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      expect(Callback).to.be.a('function');
+      const f = () => {};
+      const object = new Callback(f);
+      expect(object.$).to.equal(f);
+      expect(object.valueOf()).to.equal(f);
+      expect(object.dataView.getBigUint64(0, true)).to.equal(0x1000n);
+    })
+    it('should bind a function only once', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      const f = () => {};
+      const object1 = new Callback(f);
+      const object2 = new Callback(f);
+      expect(object1.dataView.getBigUint64(0, true)).to.equal(object2.dataView.getBigUint64(0, true));
+      expect(handlers.size).to.equal(1);
+      const object3 = new Callback(() => {});
+      expect(object3.dataView.getBigUint64(0, true)).to.not.equal(object1.dataView.getBigUint64(0, true));
+      expect(handlers.size).to.equal(2);
+    })
+    it('should decode arguments passed by the addon', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      const calls = [];
+      new Callback((...args) => calls.push(args));
+      const [ handler ] = handlers.values();
+      const dv = new DataView(new ArrayBuffer(8));
+      dv.setInt32(0, -1234, true);
+      dv.setUint8(4, 1);
+      handler(dv);
+      dv.setInt32(0, 77, true);
+      dv.setUint8(4, 0);
+      handler(dv);
+      expect(calls).to.eql([ [ -1234, true ], [ 77, false ] ]);
+    })
+    it('should record calls from Zig in statistics', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      const calls = [];
+      function hello(...args) {
+        calls.push(args);
+      }
+      new Callback(hello);
+      const [ handler ] = handlers.values();
+      env.getStatistics({ collect: true });
+      const dv = new DataView(new ArrayBuffer(8));
+      dv.setInt32(0, 1234, true);
+      handler(dv);
+      handler(dv);
+      const [ record ] = env.getStatistics({ collect: false });
+      expect(calls).to.eql([ [ 1234, false ], [ 1234, false ] ]);
+      expect(record.name).to.equal('hello');
+      expect(record.thunkId).to.equal(0x1000n);
+      expect(record.calls).to.equal(2);
+    })
+    it('should release bindings', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure, handles } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      const f1 = () => {};
+      const f2 = () => {};
+      const object = new Callback(f1);
+      new Callback(f2);
+      expect(env.releaseCallback(f1)).to.equal(1);
+      expect(handlers.size).to.equal(1);
+      expect(handles.size).to.equal(1);
+      expect(object.$).to.be.null;
+      expect(env.releaseCallback()).to.equal(1);
+      expect(handlers.size).to.equal(0);
+      expect(handles.size).to.equal(0);
+      // function gets bound again
+      new Callback(f1);
+      expect(handlers.size).to.equal(1);
+    })
+    it('should release bindings when the module is abandoned', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      new Callback(() => {});
+      env.abandon();
+      expect(handlers.size).to.equal(0);
+    })
+    it('should throw when all trampolines are in use', function() {
+      const { env, handlers } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      structure.constructor[CALLBACK_BINDER] = () => 0n;
+      expect(() => new Callback(() => {})).to.throw(Error)
+        .with.property('message').that.contains('releaseCallback');
+      expect(handlers.size).to.equal(0);
+    })
+    it('should throw when given something other than a function', function() {
+      const { env } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      expect(() => new Callback(123)).to.throw(TypeError);
+      expect(() => new Callback({})).to.throw(TypeError);
+    })
+    it('should return null when address is not bound to a JS function', function() {
+      const { env } = createEnvironment();
+      const { structure } = defineCallback(env);
+      const { constructor: Callback } = structure;
+      const dv = new DataView(new ArrayBuffer(8));
+      dv.setBigUint64(0, 0x8888n, true);
+      const object = Callback.call(ENVIRONMENT, dv);
+      expect(object.$).to.be.null;
+    })
+  })
+})
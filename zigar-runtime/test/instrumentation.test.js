@@ -0,0 +1,91 @@
+import { expect } from 'chai';
+
+import { NodeEnvironment } from '../src/environment-node.js';
+import {
+  addInstrument, invokeCallbackInstrumented, invokeInstrumented, removeInstrument
+} from '../src/instrumentation.js';
+
+describe('Instrumentation functions', function() {
+  const createInstrument = (log) => {
+    return {
+      call(thunkId, name, cb) {
+        log.push(`call ${name}`);
+        return cb();
+      },
+      measure(phase, cb) {
+        log.push(phase);
+        return cb();
+      },
+    };
+  };
+  describe('addInstrument', function() {
+    it('should wrap methods of environment', function() {
+      const env = new NodeEnvironment();
+      const runThunk = env.runThunk = () => {};
+      const log = [];
+      addInstrument(env, createInstrument(log));
+      expect(env.runThunk).to.not.equal(runThunk);
+      expect(env.hasOwnProperty('updatePointerAddresses')).to.be.true;
+      env.runThunk();
+      expect(log).to.eql([ 'native' ]);
+    })
+    it('should pass calls through all instruments', function() {
+      const env = new NodeEnvironment();
+      env.runThunk = () => {};
+      const log1 = [], log2 = [];
+      addInstrument(env, createInstrument(log1));
+      addInstrument(env, createInstrument(log2));
+      env.runThunk();
+      expect(log1).to.eql([ 'native' ]);
+      expect(log2).to.eql([ 'native' ]);
+    })
+  })
+  describe('removeInstrument', function() {
+    it('should restore original methods when the last instrument is removed', function() {
+      const env = new NodeEnvironment();
+      const runThunk = env.runThunk = () => {};
+      const instrument1 = createInstrument([]);
+      const instrument2 = createInstrument([]);
+      addInstrument(env, instrument1);
+      addInstrument(env, instrument2);
+      removeInstrument(env, instrument1);
+      expect(env.runThunk).to.not.equal(runThunk);
+      removeInstrument(env, instrument2);
+      expect(env.runThunk).to.equal(runThunk);
+      expect(env.hasOwnProperty('updatePointerAddresses')).to.be.false;
+      expect(env.instruments).to.be.null;
+    })
+  })
+  describe('invokeInstrumented', function() {
+    it('should invoke thunk with arguments', function() {
+      const env = new NodeEnvironment();
+      const log = [];
+      addInstrument(env, createInstrument(log));
+      let received;
+      env.invokeThunk = (thunkId, args) => {
+        received = [ thunkId, args ];
+        return 123;
+      };
+      const result = invokeInstrumented(env, 7, 'hello', () => 'args');
+      expect(result).to.equal(123);
+      expect(received).to.eql([ 7, 'args' ]);
+      expect(log).to.eql([ 'call hello', 'arguments' ]);
+    })
+  })
+  describe('invokeCallbackInstrumented', function() {
+    it('should invoke function with arguments', function() {
+      const env = new NodeEnvironment();
+      const log = [];
+      addInstrument(env, createInstrument(log));
+      let received;
+      const fn = (...args) => {
+        received = args;
+        return 123;
+      };
+      const result = invokeCallbackInstrumented(env, 0x8000, 'hello', () => [ 1, 2 ], fn);
+      expect(result).to.equal(123);
+      expect(received).to.eql([ 1, 2 ]);
+      expect(log).to.eql([ 'call hello', 'arguments', 'callback' ]);
+    })
+  })
+})
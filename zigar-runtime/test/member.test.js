@@ -311,6 +311,46 @@ describe('Member functions', function() {
       const { set: setNoCheck } = getDescriptor(member, { env, runtimeSafety: false });
       expect(() => setNoCheck.call(object, 32)).to.not.throw();
     })
+    it('should return 64-bit int descriptor using number when int64AsNumber is set', function() {
+      const dv = new DataView(new ArrayBuffer(16));
+      dv.setBigInt64(0, -1234567890123n, true);
+      dv.setBigUint64(8, 2n ** 60n, true);
+      const object = { [MEMORY]: dv };
+      const member1 = {
+        type: MemberType.Int,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        structure: { type: StructureType.Primitive, name: 'i64' },
+      };
+      const member2 = {
+        type: MemberType.Uint,
+        bitSize: 64,
+        bitOffset: 64,
+        byteSize: 8,
+        structure: { type: StructureType.Primitive, name: 'u64' },
+      };
+      const numberEnv = { ...env, int64AsNumber: true };
+      const { get: get1, set: set1 } = getDescriptor(member1, numberEnv);
+      const { get: get2, set: set2 } = getDescriptor(member2, numberEnv);
+      expect(get1.call(object)).to.equal(-1234567890123);
+      set1.call(object, -0x7FFF_FFFF_FFFF);
+      expect(dv.getBigInt64(0, true)).to.equal(-0x7FFF_FFFF_FFFFn);
+      set1.call(object, 123n);
+      expect(get1.call(object)).to.equal(123);
+      expect(() => get2.call(object)).to.throw(TypeError);
+      set2.call(object, Number.MAX_SAFE_INTEGER);
+      expect(get2.call(object)).to.equal(Number.MAX_SAFE_INTEGER);
+      expect(() => set2.call(object, 2 ** 60)).to.throw(TypeError);
+      expect(() => set2.call(object, -1)).to.throw(TypeError);
+      const { get: getNoCheck } = getDescriptor(member2, { ...numberEnv, runtimeSafety: false });
+      dv.setBigUint64(8, 2n ** 60n, true);
+      expect(getNoCheck.call(object)).to.equal(2 ** 60);
+      const { get: getListed } = getDescriptor(member1, { ...env, int64AsNumber: [ 'i64' ] });
+      const { get: getUnlisted } = getDescriptor(member2, { ...env, int64AsNumber: [ 'i64' ] });
+      expect(getListed.call(object)).to.equal(123);
+      expect(getUnlisted.call(object)).to.equal(2n ** 60n);
+    })
     it('should return float descriptor', function() {
       const object = {
         [MEMORY]: (() => {
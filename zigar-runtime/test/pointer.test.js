@@ -503,6 +503,254 @@ describe('Pointer functions', function() {
       object.cat = 777;
       expect(target.cat).to.equal(777);
     })
+    it('should not create proxies when pointer proxy is disabled', function() {
+      const env = new NodeEnvironment();
+      env.pointerProxy = false;
+      const structStructure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'Hello',
+        byteSize: 8,
+        hasPointer: false,
+      });
+      env.attachMember(structStructure, {
+        type: MemberType.Uint,
+        name: 'cat',
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.attachMember(structStructure, {
+        type: MemberType.Uint,
+        name: 'dog',
+        bitSize: 32,
+        bitOffset: 32,
+        byteSize: 4,
+      });
+      env.finalizeShape(structStructure);
+      env.finalizeStructure(structStructure);
+      const { constructor: Hello } = structStructure;
+      const structure = env.beginStructure({
+        type: StructureType.SinglePointer,
+        name: '*Hello',
+        byteSize: 8,
+        hasPointer: true,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: structStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: HelloPtr } = structure;
+      const target = new Hello({ cat: 123, dog: 456 });
+      const pointer = new HelloPtr(target);
+      expect(pointer.$).to.equal(pointer);
+      expect(pointer[POINTER]).to.equal(pointer);
+      expect(pointer.cat).to.be.undefined;
+      expect(pointer['*']).to.equal(target);
+      expect(pointer.deref()).to.equal(target);
+      pointer.deref().cat = 777;
+      expect(target.cat).to.equal(777);
+      pointer.$ = new Hello({ cat: 1, dog: 2 });
+      expect(pointer.deref().dog).to.equal(2);
+    })
+    it('should return stable read-only target when const pointer has no proxy', function() {
+      const env = new NodeEnvironment();
+      env.pointerProxy = false;
+      const structStructure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'Hello',
+        byteSize: 8,
+        hasPointer: false,
+      });
+      env.attachMember(structStructure, {
+        type: MemberType.Uint,
+        name: 'cat',
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.attachMember(structStructure, {
+        type: MemberType.Uint,
+        name: 'dog',
+        bitSize: 32,
+        bitOffset: 32,
+        byteSize: 4,
+      });
+      env.finalizeShape(structStructure);
+      env.finalizeStructure(structStructure);
+      const { constructor: Hello } = structStructure;
+      const structure = env.beginStructure({
+        type: StructureType.SinglePointer,
+        name: '*const Hello',
+        byteSize: 8,
+        isConst: true,
+        hasPointer: true,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: structStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: HelloPtr } = structure;
+      const object = new Hello({ cat: 123, dog: 456 });
+      const pointer = new HelloPtr(object);
+      const target = pointer.deref();
+      expect(target).to.not.equal(object);
+      expect(target).to.be.an.instanceOf(Hello);
+      expect(pointer['*']).to.equal(target);
+      expect(() => target.cat = 999).to.throw(TypeError);
+      expect(target.cat).to.equal(123);
+      object.cat = 777;
+      expect(target.cat).to.equal(777);
+      const pointer2 = new HelloPtr(target);
+      expect(pointer2.deref()).to.equal(target);
+    })
+    it('should keep children read-only when const pointer has no proxy', function() {
+      const env = new NodeEnvironment();
+      env.pointerProxy = false;
+      const innerStructure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'Inner',
+        byteSize: 4,
+        hasPointer: false,
+      });
+      env.attachMember(innerStructure, {
+        type: MemberType.Uint,
+        name: 'cat',
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.finalizeShape(innerStructure);
+      env.finalizeStructure(innerStructure);
+      const outerStructure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'Outer',
+        byteSize: 4,
+        hasPointer: false,
+      });
+      env.attachMember(outerStructure, {
+        type: MemberType.Object,
+        name: 'inner',
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+        slot: 0,
+        structure: innerStructure,
+      });
+      env.finalizeShape(outerStructure);
+      env.finalizeStructure(outerStructure);
+      const { constructor: Outer } = outerStructure;
+      const arrayStructure = env.beginStructure({
+        type: StructureType.Array,
+        name: '[2]Inner',
+        length: 2,
+        byteSize: 8,
+        hasPointer: false,
+      });
+      env.attachMember(arrayStructure, {
+        type: MemberType.Object,
+        bitSize: 32,
+        byteSize: 4,
+        structure: innerStructure,
+      });
+      env.finalizeShape(arrayStructure);
+      env.finalizeStructure(arrayStructure);
+      const { constructor: InnerArray } = arrayStructure;
+      const definePtr = (targetStructure, isConst) => {
+        const structure = env.beginStructure({
+          type: StructureType.SinglePointer,
+          name: `*${isConst ? 'const ' : ''}${targetStructure.name}`,
+          byteSize: 8,
+          isConst,
+          hasPointer: true,
+        });
+        env.attachMember(structure, {
+          type: MemberType.Object,
+          bitSize: 64,
+          bitOffset: 0,
+          byteSize: 8,
+          slot: 0,
+          structure: targetStructure,
+        });
+        env.finalizeShape(structure);
+        env.finalizeStructure(structure);
+        return structure.constructor;
+      };
+      const OuterConstPtr = definePtr(outerStructure, true);
+      const OuterPtr = definePtr(outerStructure, false);
+      const ArrayConstPtr = definePtr(arrayStructure, true);
+      const ArrayPtr = definePtr(arrayStructure, false);
+      const outer = new Outer({ inner: { cat: 123 } });
+      const constTarget = new OuterConstPtr(outer).deref();
+      expect(constTarget.inner.cat).to.equal(123);
+      expect(() => constTarget.inner.cat = 42).to.throw(TypeError);
+      expect(() => constTarget.inner = { cat: 42 }).to.throw(TypeError);
+      const target = new OuterPtr(outer).deref();
+      target.inner.cat = 42;
+      expect(constTarget.inner.cat).to.equal(42);
+      const array = new InnerArray([ { cat: 1 }, { cat: 2 } ]);
+      const constArray = new ArrayConstPtr(array).deref();
+      expect(() => constArray[0].cat = 5).to.throw(TypeError);
+      const mutableArray = new ArrayPtr(array).deref();
+      mutableArray[0].cat = 5;
+      mutableArray.get(1).cat = 6;
+      expect(constArray[0].cat).to.equal(5);
+      expect(constArray[1].cat).to.equal(6);
+    })
+    it('should not allow index assignment through const pointer when there is no proxy', function() {
+      const env = new NodeEnvironment();
+      env.pointerProxy = false;
+      const arrayStructure = env.beginStructure({
+        type: StructureType.Array,
+        name: '[4]u32',
+        length: 4,
+        byteSize: 16,
+        hasPointer: false,
+      });
+      env.attachMember(arrayStructure, {
+        type: MemberType.Uint,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { type: StructureType.Primitive, name: 'u32' },
+      });
+      env.finalizeShape(arrayStructure);
+      env.finalizeStructure(arrayStructure);
+      const { constructor: Array } = arrayStructure;
+      const structure = env.beginStructure({
+        type: StructureType.SinglePointer,
+        name: '*const [4]u32',
+        byteSize: 8,
+        isConst: true,
+        hasPointer: true,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: arrayStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: ConstPtr } = structure;
+      const array = new Array([ 1, 2, 3, 4 ]);
+      const pointer = new ConstPtr(array);
+      expect(() => pointer['*'][1] = 99).to.throw(TypeError);
+      expect(() => pointer['*'].set(1, 99)).to.throw(TypeError);
+      expect([ ...array ]).to.eql([ 1, 2, 3, 4 ]);
+    })
     it('should throw when read-only object is assigned to non-const pointer', function() {
       const structStructure = env.beginStructure({
         type: StructureType.Struct,
@@ -3456,6 +3704,76 @@ describe('Pointer functions', function() {
       expect(dv.getBigUint64(0, true)).to.equal(0n);
       expect(dv.getBigUint64(8, true)).to.equal(0n);
     })
+    it('should keep addresses as bigint when int64AsNumber is set', function() {
+      const env = new NodeEnvironment();
+      env.int64AsNumber = true;
+      const intStructure = env.beginStructure({
+        type: StructureType.Primitive,
+        name: 'u64',
+        byteSize: 8,
+      });
+      env.attachMember(intStructure, {
+        type: MemberType.Uint,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        structure: intStructure,
+      });
+      env.finalizeShape(intStructure);
+      env.finalizeStructure(intStructure);
+      const sliceStructure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_]u64',
+        byteSize: 8,
+        hasPointer: false,
+      });
+      env.attachMember(sliceStructure, {
+        type: MemberType.Uint,
+        bitSize: 64,
+        byteSize: 8,
+        structure: intStructure,
+      });
+      env.finalizeShape(sliceStructure);
+      env.finalizeStructure(sliceStructure);
+      const spStructure = env.beginStructure({
+        type: StructureType.SlicePointer,
+        name: '[]u64',
+        byteSize: 16,
+        hasPointer: true,
+      });
+      env.attachMember(spStructure, {
+        type: MemberType.Object,
+        bitSize: 64,
+        bitOffset: 0,
+        byteSize: 8,
+        slot: 0,
+        structure: sliceStructure,
+      });
+      env.finalizeShape(spStructure);
+      env.finalizeStructure(spStructure);
+      // beyond what a number can represent exactly
+      let nextAddress = 0xffff_8000_0000_1000n;
+      env.allocateExternMemory = function(type, len, align) {
+        const address = nextAddress;
+        nextAddress += 0x1000n;
+        return address;
+      };
+      env.obtainExternBuffer = function(address, len) {
+        return new ArrayBuffer(len);
+      };
+      const { constructor: U64SPtr } = spStructure;
+      const pointer1 = new U64SPtr([ 1, 2, 3 ], { fixed: true });
+      const pointer2 = new U64SPtr(undefined, { fixed: true });
+      pointer2.$ = pointer1;
+      const dv = pointer2[MEMORY];
+      expect(dv.getBigUint64(0, true)).to.equal(0xffff_8000_0000_2000n);
+      expect(dv.getBigUint64(8, true)).to.equal(3n);
+      pointer2[TARGET_UPDATER]();
+      expect(pointer2[ADDRESS]).to.equal(0xffff_8000_0000_2000n);
+      expect(pointer2[LENGTH]).to.equal(3);
+      expect([ ...pointer2 ]).to.eql([ 1, 2, 3 ]);
+      expect(pointer2[0]).to.be.a('number');
+    })
     it('should immediately update a C pointer in fixed memory', function() {
       const intStructure = env.beginStructure({
         type: StructureType.Primitive,
@@ -3,7 +3,7 @@ import { expect } from 'chai';
 import { NodeEnvironment } from '../src/environment-node.js';
 import { useAllMemberTypes } from '../src/member.js';
 import { useAllStructureTypes } from '../src/structure.js';
-import { MEMORY } from '../src/symbol.js';
+import { MEMORY, PACKED } from '../src/symbol.js';
 import { encodeBase64 } from '../src/text.js';
 import { MemberType, StructureType } from '../src/types.js';
 
@@ -386,6 +386,27 @@ describe('Slice functions', function() {
         expect(slice[i]).to.equal(str.charCodeAt(i));
       }
     })
+    it('should allocate shared memory when requested', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_]u8',
+        byteSize: 1,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Uint,
+        bitSize: 8,
+        byteSize: 1,
+        structure: { constructor: function() {}, typedArray: Uint8Array }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: U8Slice } = structure;
+      const slice = new U8Slice([ 1, 2, 3, 4 ], { shared: true });
+      expect(slice.typedArray.buffer).to.be.an.instanceOf(SharedArrayBuffer);
+      const other = U8Slice(new Uint8Array(slice.dataView.buffer));
+      other[0] = 100;
+      expect(slice[0]).to.equal(100);
+    })
     it('should allow assignment of string to []u16', function() {
       const structure = env.beginStructure({
         type: StructureType.Slice,
@@ -1337,5 +1358,215 @@ describe('Slice functions', function() {
       expect(() => slice.$.typedArray = new Uint8Array(array)).to.throw(TypeError)
         .with.property('message').that.contains(4);
     })
+    it('should copy numbers in bulk using getRange, setRange, and fill', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: 'Hello',
+        byteSize: 2,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Uint,
+        bitSize: 16,
+        byteSize: 2,
+        structure: { constructor: function() {}, typedArray: Uint16Array }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const slice = new Hello(new Uint16Array([ 1, 2, 3, 4, 5 ]));
+      expect(slice.getRange(1, 3)).to.eql(new Uint16Array([ 2, 3 ]));
+      slice.setRange(3, [ 40, 50 ]);
+      slice.fill(7, 0, 2);
+      expect([ ...slice ]).to.eql([ 7, 7, 3, 40, 50 ]);
+      expect(() => slice.setRange(0, [ -1 ])).to.throw(TypeError);
+      const sub = slice.subarray(1, 3);
+      sub.fill(0);
+      expect([ ...slice ]).to.eql([ 7, 0, 0, 40, 50 ]);
+    })
+    it('should copy 128-bit integers in bulk as pairs of 64-bit words', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: 'Hello',
+        byteSize: 16,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Int,
+        bitSize: 128,
+        byteSize: 16,
+        structure: { constructor: function() {} }
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const slice = new Hello([ 1n, -2n, 2n ** 100n ]);
+      const words = slice.getRange(1);
+      expect(words).to.be.instanceOf(BigUint64Array);
+      expect(words).to.eql(new BigUint64Array([ 2n ** 64n - 2n, 2n ** 64n - 1n, 0n, 2n ** 36n ]));
+      slice.setRange(0, new BigUint64Array([ 5n, 0n, 0n, 1n ]));
+      expect([ ...slice ]).to.eql([ 5n, 2n ** 64n, 2n ** 100n ]);
+      expect(() => slice.setRange(0, new BigUint64Array(3))).to.throw(TypeError);
+      expect(() => slice.setRange(2, new BigUint64Array(4))).to.throw(RangeError);
+    })
+    it('should provide a flat typed array for a slice of vectors', function() {
+      const vectorStructure = env.beginStructure({
+        type: StructureType.Vector,
+        name: '@Vector(4, f32)',
+        length: 4,
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(vectorStructure, {
+        type: MemberType.Float,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Float32Array },
+      });
+      env.finalizeShape(vectorStructure);
+      env.finalizeStructure(vectorStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[]@Vector(4, f32)',
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        byteSize: 16,
+        structure: vectorStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const slice = new Hello(new Float32Array([ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 ]));
+      expect(slice).to.have.lengthOf(3);
+      expect([ ...slice[2] ]).to.eql([ 9, 10, 11, 12 ]);
+      const ta = slice.typedArray;
+      expect(ta).to.be.an.instanceOf(Float32Array);
+      expect(ta).to.have.lengthOf(12);
+      ta[4] = 50;
+      expect(slice[1][0]).to.equal(50);
+      expect(() => new Hello(new Float32Array(6))).to.throw(TypeError);
+      // cast without copying
+      const flat = new Float32Array(8);
+      const cast = Hello(flat);
+      expect(cast).to.have.lengthOf(2);
+      cast[1][3] = 123;
+      expect(flat[7]).to.equal(123);
+    })
+    it('should not provide a flat typed array when vectors are padded', function() {
+      const vectorStructure = env.beginStructure({
+        type: StructureType.Vector,
+        name: '@Vector(3, f32)',
+        length: 3,
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(vectorStructure, {
+        type: MemberType.Float,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Float32Array },
+      });
+      env.finalizeShape(vectorStructure);
+      env.finalizeStructure(vectorStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[]@Vector(3, f32)',
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        byteSize: 16,
+        structure: vectorStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      expect(structure.typedArray).to.be.null;
+      const slice = new Hello([ [ 1, 2, 3 ], [ 4, 5, 6 ] ]);
+      expect(slice.typedArray).to.be.undefined;
+      expect(() => new Hello(new Float32Array(6))).to.throw(TypeError);
+    })
+    it('should encode a list of strings into a single buffer', function() {
+      const u8Structure = env.beginStructure({
+        type: StructureType.Primitive,
+        name: 'u8',
+        byteSize: 1,
+        align: 1,
+      });
+      env.attachMember(u8Structure, {
+        type: MemberType.Uint,
+        bitSize: 8,
+        bitOffset: 0,
+        byteSize: 1,
+      });
+      env.finalizeShape(u8Structure);
+      env.finalizeStructure(u8Structure);
+      const sliceStructure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_]const u8',
+        byteSize: 1,
+        align: 1,
+      });
+      env.attachMember(sliceStructure, {
+        type: MemberType.Uint,
+        bitSize: 8,
+        byteSize: 1,
+        structure: u8Structure,
+      });
+      env.finalizeShape(sliceStructure);
+      env.finalizeStructure(sliceStructure);
+      const ptrStructure = env.beginStructure({
+        type: StructureType.SlicePointer,
+        name: '[]const u8',
+        byteSize: 16,
+        align: 8,
+        isConst: true,
+        hasPointer: true,
+      });
+      env.attachMember(ptrStructure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        bitOffset: 0,
+        byteSize: 16,
+        slot: 0,
+        structure: sliceStructure,
+      });
+      env.finalizeShape(ptrStructure);
+      env.finalizeStructure(ptrStructure);
+      const structure = env.beginStructure({
+        type: StructureType.Slice,
+        name: '[_][]const u8',
+        byteSize: 16,
+        align: 8,
+        hasPointer: true,
+      });
+      env.attachMember(structure, {
+        type: MemberType.Object,
+        bitSize: 128,
+        byteSize: 16,
+        structure: ptrStructure,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const texts = [ 'Hello', 'wörld', '', '🌍' ];
+      const list = new Hello(texts);
+      expect(list).to.have.lengthOf(4);
+      expect([ ...list ].map(p => p.string)).to.eql(texts);
+      const dvs = [ ...list ].map(p => p['*'][MEMORY]);
+      const { buffer } = dvs[0];
+      expect(buffer[PACKED]).to.be.true;
+      expect(buffer.byteLength).to.equal(5 + 6 + 0 + 4);
+      expect(dvs.every(dv => dv.buffer === buffer)).to.be.true;
+      expect(dvs.map(dv => dv.byteOffset)).to.eql([ 0, 5, 11, 11 ]);
+      // other values go through the pointers' setters
+      const mixed = new Hello([ 'Hello', { string: 'world' } ]);
+      expect(mixed[0]['*'][MEMORY].buffer).to.not.equal(mixed[1]['*'][MEMORY].buffer);
+      expect(mixed[1].string).to.equal('world');
+    })
   })
 })
@@ -193,6 +193,93 @@ describe('Special property functions', function() {
         expect(dv2.getUint16(i * 2, true)).to.equal(`1234`.charCodeAt(i));
       }
     })
+    it('should use native string functions when environment provides them', function() {
+      const structure = {
+        name: '[5]u16',
+        byteSize: 10,
+        instance: {
+          members: [
+            {
+              type: MemberType.Uint,
+              bitSize: 16,
+              byteSize: 2,
+            }
+          ]
+        }
+      };
+      const calls = [];
+      const env = {
+        createString(address, len, charSize) {
+          calls.push([ 'createString', address, len, charSize ]);
+          return 'Hello';
+        },
+        encodeString(str, charSize) {
+          calls.push([ 'encodeString', str, charSize ]);
+          const ta = new Uint16Array([ ...str ].map(c => c.charCodeAt(0)));
+          return new DataView(ta.buffer);
+        },
+      };
+      const { get, set } = getStringDescriptor(structure, {}, env);
+      const dv = new DataView(new ArrayBuffer(10));
+      dv[FIXED] = { address: 0x1000n, len: 10 };
+      const object = {
+        dataView: dv,
+        length: 5,
+        [MEMORY]: dv,
+        [MEMORY_RESTORER]: function() {},
+        [COPIER]: getMemoryCopier(10, true),
+      };
+      expect(get.call(object)).to.equal('Hello');
+      expect(calls[0]).to.eql([ 'createString', 0x1000n, 5, 2 ]);
+      set.call(object, 'World');
+      expect(calls[1]).to.eql([ 'encodeString', 'World', 2 ]);
+      for (let i = 0; i < 5; i++) {
+        expect(object.dataView.getUint16(i * 2, true)).to.equal('World'.charCodeAt(i));
+      }
+      // relocatable memory is decoded in JavaScript
+      const object2 = {
+        dataView: new DataView(new ArrayBuffer(4)),
+        length: 2,
+      };
+      object2.dataView.setUint16(0, 'H'.charCodeAt(0), true);
+      object2.dataView.setUint16(2, 'i'.charCodeAt(0), true);
+      expect(get.call(object2)).to.equal('Hi');
+      expect(calls).to.have.lengthOf(2);
+    })
+    it('should not decode string from memory of unmapped file', function() {
+      const structure = {
+        name: '[5]u8',
+        byteSize: 5,
+        instance: {
+          members: [
+            {
+              type: MemberType.Uint,
+              bitSize: 8,
+              byteSize: 1,
+            }
+          ]
+        }
+      };
+      let called = false;
+      const env = {
+        createString(address, len, charSize) {
+          called = true;
+          return 'Hello';
+        },
+      };
+      const { get } = getStringDescriptor(structure, {}, env);
+      const buffer = new ArrayBuffer(5);
+      const dv = new DataView(buffer);
+      dv[FIXED] = { address: 0x1000n, len: 5 };
+      const object = {
+        dataView: dv,
+        length: 5,
+      };
+      // unmapping the file detaches its buffer
+      structuredClone(buffer, { transfer: [ buffer ] });
+      expect(() => get.call(object)).to.throw(TypeError);
+      expect(called).to.be.false;
+    })
     it('should return getter and setter for array with sentinel value', function() {
       const structure = {
         name: '[4]u8',
@@ -0,0 +1,108 @@
+import { expect } from 'chai';
+
+import { NodeEnvironment } from '../src/environment-node.js';
+import { invokeCallbackInstrumented } from '../src/instrumentation.js';
+import { CallStatistics } from '../src/statistics.js';
+import { MEMORY } from '../src/symbol.js';
+
+describe('Call statistics', function() {
+  const createCaller = (env) => {
+    const argStruct = {
+      constructor: function(args) {
+        this[MEMORY] = new DataView(new ArrayBuffer(8));
+        this.retval = args[0] * 2;
+      },
+    };
+    return env.createCaller({ name: 'hello', argStruct, thunkId: 100 }, false);
+  };
+  describe('getStatistics', function() {
+    it('should return empty list when statistics are not collected', function() {
+      const env = new NodeEnvironment();
+      env.runThunk = () => {};
+      const hello = createCaller(env);
+      expect(hello(1)).to.equal(2);
+      expect(env.getStatistics()).to.eql([]);
+      expect(env.statistics).to.be.null;
+    })
+    it('should record calls to function', function() {
+      const env = new NodeEnvironment();
+      env.getBufferAddress = () => 0x1000n;
+      const runThunk = env.runThunk = () => {
+        env.allocateHostMemory(16, 4);
+        const end = performance.now() + 1;
+        while (performance.now() < end);
+      };
+      const hello = createCaller(env);
+      env.getStatistics({ collect: true });
+      expect(env.statistics).to.be.an.instanceOf(CallStatistics);
+      expect(env.runThunk).to.not.equal(runThunk);
+      for (let i = 0; i < 3; i++) {
+        expect(hello(i)).to.equal(i * 2);
+      }
+      const [ record ] = env.getStatistics();
+      expect(record.name).to.equal('hello');
+      expect(record.thunkId).to.equal(100);
+      expect(record.calls).to.equal(3);
+      expect(record.allocations).to.equal(3);
+      expect(record.nativeTime).to.be.at.least(3);
+      expect(record.totalTime).to.be.at.least(record.nativeTime);
+      expect(record.marshalInTime).to.be.at.least(0);
+      expect(record.marshalOutTime).to.be.at.least(0);
+      expect(record.p50).to.be.at.least(1);
+      expect(record.p99).to.be.at.least(record.p50);
+      expect(record.phases.native.p50).to.be.at.least(1);
+      expect(record.phases.native.p50).to.be.at.most(record.p50);
+      expect(record.phases.marshalIn.p99).to.be.at.least(0);
+      expect(record.phases.marshalOut.p99).to.be.at.least(0);
+      const list = env.getStatistics({ reset: true });
+      expect(list).to.have.lengthOf(1);
+      expect(env.getStatistics()).to.eql([]);
+      env.getStatistics({ collect: false });
+      expect(env.statistics).to.be.null;
+      expect(env.runThunk).to.equal(runThunk);
+      expect(Object.getOwnPropertyDescriptor(env, 'allocateHostMemory')).to.be.undefined;
+      expect(env.instruments).to.be.null;
+    })
+    it('should count bytes copied from Zig memory', function() {
+      const env = new NodeEnvironment();
+      env.copyBytes = () => {};
+      env.runThunk = () => {
+        env.captureView(0x1000n, 32, true);
+      };
+      const hello = createCaller(env);
+      env.getStatistics({ collect: true });
+      hello(1);
+      const [ record ] = env.getStatistics({ collect: false });
+      expect(record.bytesCopied).to.equal(32);
+    })
+    it('should record calls from Zig to JavaScript', function() {
+      const env = new NodeEnvironment();
+      env.getStatistics({ collect: true });
+      const fn = (a, b) => {
+        const end = performance.now() + 1;
+        while (performance.now() < end);
+        return a + b;
+      };
+      const result = invokeCallbackInstrumented(env, 0x8000, 'callback', () => [ 1, 2 ], fn);
+      expect(result).to.equal(3);
+      const [ record ] = env.getStatistics({ collect: false });
+      expect(record.name).to.equal('callback');
+      expect(record.thunkId).to.equal(0x8000);
+      expect(record.calls).to.equal(1);
+      // time spent in the JavaScript function counts as native time
+      expect(record.nativeTime).to.be.at.least(1);
+      expect(record.phases.native.p50).to.be.at.least(1);
+    })
+    it('should be accessible through special exports', function() {
+      const env = new NodeEnvironment();
+      env.runThunk = () => {};
+      const hello = createCaller(env);
+      const { stats } = env.getSpecialExports();
+      stats({ collect: true });
+      hello(1);
+      hello(2);
+      expect(stats()[0].calls).to.equal(2);
+      stats({ collect: false });
+    })
+  })
+})
@@ -4,7 +4,8 @@ import { useAllExtendedTypes } from '../src/data-view.js';
 import { NodeEnvironment } from '../src/environment-node.js';
 import { useAllMemberTypes } from '../src/member.js';
 import { useAllStructureTypes } from '../src/structure.js';
-import { ENVIRONMENT, MEMORY, SLOTS } from '../src/symbol.js';
+import { getAsyncIteratorIterator, getIteratorIterator } from '../src/struct.js';
+import { ENVIRONMENT, MEMORY, NEXT_BATCH, SLOTS } from '../src/symbol.js';
 import { encodeBase64 } from '../src/text.js';
 import { MemberType, StructureType } from '../src/types.js';
 
@@ -97,6 +98,40 @@ describe('Struct functions', function() {
       const object3 = Hello(dv);
       expect(object3).to.equal(object1);
     })
+    it('should allocate shared memory when requested', function() {
+      const structure = env.beginStructure({
+        type: StructureType.Struct,
+        name: 'Hello',
+        byteSize: 4 * 2,
+      });
+      env.attachMember(structure, {
+        name: 'dog',
+        type: MemberType.Int,
+        bitSize: 32,
+        bitOffset: 0,
+        byteSize: 4,
+      });
+      env.attachMember(structure, {
+        name: 'cat',
+        type: MemberType.Int,
+        bitSize: 32,
+        bitOffset: 32,
+        byteSize: 4,
+      });
+      env.finalizeShape(structure);
+      env.finalizeStructure(structure);
+      const { constructor: Hello } = structure;
+      const object1 = new Hello({ dog: 1234, cat: 4567 }, { shared: true });
+      expect(object1.dataView.buffer).to.be.an.instanceOf(SharedArrayBuffer);
+      expect(env.sharing).to.be.false;
+      const object2 = new Hello({ dog: 1, cat: 2 });
+      expect(object2.dataView.buffer).to.be.an.instanceOf(ArrayBuffer);
+      // same thing that happens in a worker receiving the buffer through postMessage()
+      const object3 = Hello(object1.dataView.buffer);
+      expect(object3.valueOf()).to.eql({ dog: 1234, cat: 4567 });
+      object3.dog = 777;
+      expect(object1.dog).to.equal(777);
+    })
     it('should initialize fields from object', function() {
       const structure = env.beginStructure({
         type: StructureType.Struct,
@@ -1396,6 +1431,84 @@ describe('Struct functions', function() {
       expect(results).to.eql([ 1, 2, 3, 4, 5 ]);
     })
   })
+  describe('getIteratorIterator', function() {
+    const createIterable = (count, failAt = -1) => {
+      const sizes = [];
+      let index = 0;
+      return {
+        sizes,
+        [NEXT_BATCH](size) {
+          sizes.push(size);
+          const items = [];
+          let end = false, error = null;
+          while (items.length < size) {
+            if (index === failAt) {
+              index++;
+              error = new Error('Unlucky');
+              break;
+            } else if (index >= count) {
+              end = true;
+              break;
+            }
+            items.push(index++);
+          }
+          return {
+            items,
+            len: items.length,
+            end,
+            get err() {
+              if (error) throw error;
+            },
+          };
+        },
+        [Symbol.iterator]: getIteratorIterator,
+        [Symbol.asyncIterator]: getAsyncIteratorIterator,
+      };
+    }
+    it('should fetch items in batches of increasing size', function() {
+      const object = createIterable(10);
+      const results = [];
+      for (const value of object) {
+        results.push(value);
+      }
+      expect(results).to.eql([ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 ]);
+      expect(object.sizes).to.eql([ 1, 2, 4, 8 ]);
+    })
+    it('should throw error after items preceding it have been consumed', function() {
+      const object = createIterable(10, 4);
+      const iterator = object[Symbol.iterator]();
+      const results = [];
+      for (let i = 0; i < 4; i++) {
+        results.push(iterator.next().value);
+      }
+      expect(results).to.eql([ 0, 1, 2, 3 ]);
+      expect(() => iterator.next()).to.throw('Unlucky');
+      expect(iterator.next()).to.eql({ value: 5, done: false });
+    })
+    it('should work with for await', async function() {
+      const object = createIterable(100);
+      const results = [];
+      for await (const value of object) {
+        results.push(value);
+      }
+      expect(results).to.have.lengthOf(100);
+      expect(results[99]).to.equal(99);
+    })
+    it('should reject when an error is encountered', async function() {
+      const object = createIterable(10, 2);
+      const results = [];
+      let error;
+      try {
+        for await (const value of object) {
+          results.push(value);
+        }
+      } catch (err) {
+        error = err;
+      }
+      expect(results).to.eql([ 0, 1 ]);
+      expect(error).to.be.an('error').with.property('message', 'Unlucky');
+    })
+  })
 })
 
 function viewOf(ta) {
@@ -5,6 +5,7 @@ import {
   decodeText,
   encodeBase64,
   encodeText,
+  encodeTextList,
 } from '../src/text.js';
 
 describe('Text functions', function() {
@@ -65,6 +66,37 @@ describe('Text functions', function() {
         expect(c).to.equal(text.charCodeAt(index));
       }
     })
+    it('should convert a string with surrogate pairs to Uint16Array', function() {
+      const text = 'Hello 🌍! '.repeat(100);
+      const ta = encodeText(text, 'utf-16');
+      expect(ta).to.be.an.instanceOf(Uint16Array);
+      expect(ta).to.have.lengthOf(text.length);
+      expect(ta.byteOffset).to.equal(0);
+      for (const [ index, c ] of ta.entries()) {
+        expect(c).to.equal(text.charCodeAt(index));
+      }
+    })
+  })
+  describe('encodeTextList', function() {
+    it('should encode a list of strings into a single array', function() {
+      const texts = [ 'Hello', '', 'world', '!' ];
+      const { array, ends } = encodeTextList(texts);
+      expect(array).to.be.an.instanceOf(Uint8Array);
+      expect(array).to.have.lengthOf(11);
+      expect(ends).to.eql([ 5, 5, 10, 11 ]);
+      expect(decodeText(array)).to.equal('Helloworld!');
+    })
+    it('should handle strings that are not ASCII', function() {
+      const texts = [ 'abc', 'Hello 🌍! '.repeat(10), 'Здравствуйте', 'xyz' ];
+      const { array, ends } = encodeTextList(texts);
+      let start = 0;
+      for (const [ index, text ] of texts.entries()) {
+        const end = ends[index];
+        expect(decodeText(array.subarray(start, end))).to.equal(text);
+        start = end;
+      }
+      expect(ends[ends.length - 1]).to.equal(array.length);
+    })
   })
   describe('encodeBase64', function() {
     it('should encode data view to base64 string', function() {
@@ -0,0 +1,84 @@
+import { expect } from 'chai';
+
+import { NodeEnvironment } from '../src/environment-node.js';
+import { MEMORY } from '../src/symbol.js';
+import { CallTracer } from '../src/tracing.js';
+
+describe('Call tracing', function() {
+  const createCaller = (env, name) => {
+    const argStruct = {
+      constructor: function(args) {
+        this[MEMORY] = new DataView(new ArrayBuffer(8));
+        this.retval = args[0] * 2;
+      },
+    };
+    return env.createCaller({ name, argStruct, thunkId: 100 }, false);
+  };
+  const observeSpans = () => {
+    const spans = [];
+    const observer = new PerformanceObserver(list => spans.push(...list.getEntries()));
+    observer.observe({ entryTypes: [ 'measure' ] });
+    // observers are notified asynchronously; take entries that haven't been delivered yet
+    const collect = () => [ ...spans.splice(0), ...observer.takeRecords() ];
+    const stop = () => observer.disconnect();
+    return { collect, stop };
+  };
+  describe('setTracing', function() {
+    it('should emit spans for phases of function call', function() {
+      const env = new NodeEnvironment();
+      env.getBufferAddress = () => 0x1000n;
+      env.runThunk = () => {
+        env.allocateHostMemory(16, 4);
+      };
+      const traceMe = createCaller(env, 'traceMe');
+      const { collect, stop } = observeSpans();
+      try {
+        expect(env.setTracing(true)).to.be.false;
+        expect(env.tracer).to.be.an.instanceOf(CallTracer);
+        expect(traceMe(4)).to.equal(8);
+        const spans = collect();
+        const names = spans.map(e => e.name);
+        expect(names).to.include('traceMe');
+        expect(names).to.include('traceMe:arguments');
+        expect(names).to.include('traceMe:native');
+        expect(names).to.include('traceMe:allocate');
+        expect(names).to.include('traceMe:console');
+        const span = spans.find(e => e.name === 'traceMe');
+        expect(span.detail).to.eql({ thunkId: 100 });
+        expect(env.setTracing(false)).to.be.true;
+        expect(env.tracer).to.be.null;
+        traceMe(4);
+        expect(collect()).to.have.lengthOf(0);
+      } finally {
+        stop();
+      }
+    })
+    it('should not leave spans in the performance timeline', function() {
+      const env = new NodeEnvironment();
+      env.runThunk = () => {};
+      const traceMe = createCaller(env, 'traceMe');
+      env.setTracing(true);
+      for (let i = 0; i < 100; i++) {
+        traceMe(i);
+      }
+      env.setTracing(false);
+      expect(performance.getEntriesByType('measure')).to.have.lengthOf(0);
+    })
+    it('should be accessible through special exports', function() {
+      const env = new NodeEnvironment();
+      env.runThunk = () => {};
+      const traceMeToo = createCaller(env, 'traceMeToo');
+      const { trace } = env.getSpecialExports();
+      const { collect, stop } = observeSpans();
+      try {
+        trace(true);
+        traceMeToo(1);
+        trace(false);
+        const spans = collect();
+        expect(spans.filter(e => e.name === 'traceMeToo')).to.have.lengthOf(1);
+      } finally {
+        stop();
+      }
+    })
+  })
+})
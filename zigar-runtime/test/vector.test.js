@@ -338,6 +338,57 @@ describe('Vector functions', function() {
       const vector = Vector(array);
       expect([ ...vector ]).to.eql([ 1, 2, 3, 4 ]);
     })
+    it('should copy elements from a typed array in one go', function() {
+      const vectorStructure = env.beginStructure({
+        type: StructureType.Vector,
+        name: '@Vector(4, f32)',
+        length: 4,
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(vectorStructure, {
+        type: MemberType.Float,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Float32Array },
+      });
+      env.finalizeShape(vectorStructure);
+      env.finalizeStructure(vectorStructure);
+      const { constructor: Vector } = vectorStructure;
+      const vector = new Vector(new Float32Array([ 1.5, 2.5, 3.5, 4.5 ]));
+      expect([ ...vector ]).to.eql([ 1.5, 2.5, 3.5, 4.5 ]);
+      vector.$ = new Float32Array([ 5, 6, 7, 8 ]);
+      expect([ ...vector ]).to.eql([ 5, 6, 7, 8 ]);
+      expect(() => vector.$ = new Float32Array(3)).to.throw(TypeError);
+    })
+    it('should give a typed array covering only the elements of a padded vector', function() {
+      const vectorStructure = env.beginStructure({
+        type: StructureType.Vector,
+        name: '@Vector(3, f32)',
+        length: 3,
+        byteSize: 16,
+        align: 16,
+      });
+      env.attachMember(vectorStructure, {
+        type: MemberType.Float,
+        bitSize: 32,
+        byteSize: 4,
+        structure: { constructor: function() {}, typedArray: Float32Array },
+      });
+      env.finalizeShape(vectorStructure);
+      env.finalizeStructure(vectorStructure);
+      const { constructor: Vector } = vectorStructure;
+      const vector = new Vector([ 1, 2, 3 ]);
+      const ta = vector.typedArray;
+      expect(ta).to.be.an.instanceOf(Float32Array);
+      expect(ta).to.have.lengthOf(3);
+      ta[2] = 4;
+      expect(vector[2]).to.equal(4);
+      vector.typedArray = new Float32Array([ 7, 8, 9 ]);
+      expect([ ...vector ]).to.eql([ 7, 8, 9 ]);
+      expect(() => vector.typedArray = new Float32Array(4)).to.throw(TypeError);
+      expect(() => vector.typedArray = new Int32Array(3)).to.throw(TypeError);
+    })
     it('should throw when there is not enough initializers', function() {
       const structure = env.beginStructure({
         type: StructureType.Vector,